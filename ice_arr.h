@@ -192,6 +192,56 @@ THE SOFTWARE.
 #  define ICE_ARR_API ICE_ARR_APIDEF ICE_ARR_INLINEDEF
 #endif
 
+// SIMD backends are detected from compiler flags, Define ICE_ARR_NO_SIMD to use scalar code only
+#if !defined(ICE_ARR_NO_SIMD)
+#  if defined(__AVX__)
+#    define ICE_ARR_AVX
+#  elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ICE_ARR_SSE2
+#  elif (defined(__ARM_NEON) || defined(_M_ARM64)) && (defined(__aarch64__) || defined(_M_ARM64))
+#    define ICE_ARR_NEON
+#  endif
+#endif
+
+// File IO (ice_arr_save, ice_arr_load, ice_arr_map_file), Define ICE_ARR_NO_FILE to leave it out so library only needs libc
+// NOTE: Files are mapped on Microsoft and Unix-like platforms, On other platforms ice_arr_map_file returns empty view.
+#if !defined(ICE_ARR_NO_FILE)
+#  if defined(ICE_ARR_MICROSOFT)
+#    define ICE_ARR_MMAP_WIN32
+#  elif defined(ICE_ARR_PLATFORM_UNIX) || defined(ICE_ARR_PLATFORM_BEOS) || defined(__unix__) || defined(__unix) || defined(__APPLE__) || defined(__HAIKU__)
+#    define ICE_ARR_MMAP_POSIX
+#  endif
+#endif
+
+// Parallel execution of bulk operations (ice_arr_fill, ice_arr_clear, ice_arr_sum, ice_arr_min, ice_arr_max, ice_arr_matches, ice_arr_foreach, ice_arr_sort, ice_arr_sort_asc)
+// NOTE: Define ICE_ARR_PARALLEL to enable it, Requires pthreads and ice_cpu.h (Implemented with ICE_CPU_IMPL in one of your source files).
+#if defined(ICE_ARR_PARALLEL)
+#  ifndef ICE_ARR_PARALLEL_MIN
+#    define ICE_ARR_PARALLEL_MIN 262144         // Arrays with less elements run on calling thread
+#  endif
+#  ifndef ICE_ARR_PARALLEL_CHUNK
+#    define ICE_ARR_PARALLEL_CHUNK 32768        // Elements per task (256 KB of doubles, Fits L2 cache)
+#  endif
+#  ifndef ICE_ARR_PARALLEL_MAX_THREADS
+#    define ICE_ARR_PARALLEL_MAX_THREADS 64
+#  endif
+#endif
+
+// Minimum capacity (in elements) allocated once array needs to grow
+#ifndef ICE_ARR_MIN_CAPACITY
+#  define ICE_ARR_MIN_CAPACITY 8
+#endif
+
+// Elements stored inside ice_arr_small struct before it allocates
+#ifndef ICE_ARR_SMALL_CAPACITY
+#  define ICE_ARR_SMALL_CAPACITY 8
+#endif
+
+// Elements per call of ice_arr_foreach_chunk callback (8 KB of doubles, Fits L1 cache)
+#ifndef ICE_ARR_FOREACH_CHUNK
+#  define ICE_ARR_FOREACH_CHUNK 1024
+#endif
+
 // Custom memory allocators
 #ifndef ICE_ARR_MALLOC
 #  define ICE_ARR_MALLOC(sz) malloc(sz)
@@ -206,6 +256,9 @@ THE SOFTWARE.
 #  define ICE_ARR_FREE(ptr) free(ptr)
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -218,15 +271,182 @@ typedef enum ice_arr_bool {
     ICE_ARR_FALSE   = -1,
 } ice_arr_bool;
 
+typedef enum ice_arr_sort_mode {
+    ICE_ARR_SORT_INTRO  = 0,    // Introsort (Quicksort with Heapsort fallback and Insertion sort for small ranges)
+    ICE_ARR_SORT_RADIX  = 1,    // LSD Radix sort over double bits (Needs extra memory, Falls back to Introsort if allocation fails)
+} ice_arr_sort_mode;
+
+typedef enum ice_arr_set_mode {
+    ICE_ARR_SET_HASH    = 0,    // Hash set, Expected O(n) and keeps order of elements (Needs extra memory)
+    ICE_ARR_SET_SORTED  = 1,    // Sort-merge, O(n log n) and sorts input arrays in place (No extra memory, Result is sorted)
+} ice_arr_set_mode;
+
+typedef enum ice_arr_sum_mode {
+    ICE_ARR_SUM_FAST        = 0,    // SIMD summation with multiple accumulators (Fastest)
+    ICE_ARR_SUM_KAHAN       = 1,    // Compensated (Kahan-Neumaier) summation (Most accurate)
+    ICE_ARR_SUM_PAIRWISE    = 2,    // Pairwise summation (Accurate and nearly as fast as ICE_ARR_SUM_FAST)
+} ice_arr_sum_mode;
+
+// Typed arrays, Same as ice_arr_array but with element type T (P is name prefix, S is type used for sums and dot products)
+// NOTE: Sort/sum/set modes (_with_mode functions), ice_arr_sort_ex, Eytzinger layout, rings, small arrays, digests, map/foreach, parallel execution and ice_arr_map_file are for ice_arr_array only (Convert with P##_to_array/P##_from_array)
+#define ICE_ARR_DECLARE_TYPED(P, T, S) \
+    typedef struct P { \
+        T* arr; \
+        int len; \
+        int real_len; \
+    } P; \
+    \
+    typedef struct P##_view { \
+        T* arr; \
+        int len; \
+        int stride; \
+    } P##_view; \
+    \
+    typedef int (*P##_pred_func)(T n); \
+    \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_new(int len); \
+    ICE_ARR_API  T              ICE_ARR_CALLCONV  P##_get(P arr, int index); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_set(P* arr, int index, T val); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_len(P arr); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_pop(P* arr); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_push(P* arr, T val); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_push_n(P* arr, T* vals, int count); \
+    ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  P##_reserve(P* arr, int capacity); \
+    ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  P##_shrink_to_fit(P* arr); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_free(P arr); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_fill(P* arr, T val); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_clear(P* arr); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_rev(P* arr); \
+    ICE_ARR_API  S              ICE_ARR_CALLCONV  P##_sum(P arr); \
+    ICE_ARR_API  T              ICE_ARR_CALLCONV  P##_min(P arr); \
+    ICE_ARR_API  T              ICE_ARR_CALLCONV  P##_max(P arr); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_matches(P arr, T val); \
+    ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  P##_includes(P arr, T val); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_first_index(P arr, T val); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_last_index(P arr, T val); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_concat(P a1, P a2); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_sub(P arr, int from, int to); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_sort(P* arr); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_sort_asc(P* arr); \
+    \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_unique(P arr); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_diff(P a1, P a2); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_except(P a1, P a2); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_intersect(P a1, P a2); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_union(P a1, P a2); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_remove_all(P* arr, T val); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_compact_inplace(P* arr); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_dedup_inplace(P* arr); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_filter_inplace(P* arr, P##_pred_func f); \
+    \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_lower_bound(P arr, T val); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_upper_bound(P arr, T val); \
+    ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  P##_sorted_includes(P arr, T val); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_sorted_intersect(P a1, P a2); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_sorted_union(P a1, P a2); \
+    \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_add(P a1, P a2); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_add_inplace(P* a1, P a2); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_mul(P a1, P a2); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_mul_inplace(P* a1, P a2); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_scale(P arr, T alpha); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_scale_inplace(P* arr, T alpha); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_axpy(T alpha, P x, P y); \
+    ICE_ARR_API  void           ICE_ARR_CALLCONV  P##_axpy_inplace(T alpha, P x, P* y); \
+    ICE_ARR_API  S              ICE_ARR_CALLCONV  P##_dot(P a1, P a2); \
+    \
+    ICE_ARR_API  P##_view       ICE_ARR_CALLCONV  P##_view_of(P arr); \
+    ICE_ARR_API  P##_view       ICE_ARR_CALLCONV  P##_first_view(P arr, int elems); \
+    ICE_ARR_API  P##_view       ICE_ARR_CALLCONV  P##_last_view(P arr, int elems); \
+    ICE_ARR_API  P##_view       ICE_ARR_CALLCONV  P##_sub_view(P arr, int from, int to); \
+    ICE_ARR_API  P##_view       ICE_ARR_CALLCONV  P##_tail_view(P arr); \
+    ICE_ARR_API  P##_view       ICE_ARR_CALLCONV  P##_view_sub(P##_view view, int from, int to); \
+    ICE_ARR_API  P##_view       ICE_ARR_CALLCONV  P##_view_step(P##_view view, int step); \
+    ICE_ARR_API  T              ICE_ARR_CALLCONV  P##_view_get(P##_view view, int index); \
+    ICE_ARR_API  int            ICE_ARR_CALLCONV  P##_view_len(P##_view view); \
+    ICE_ARR_API  S              ICE_ARR_CALLCONV  P##_view_sum(P##_view view); \
+    ICE_ARR_API  T              ICE_ARR_CALLCONV  P##_view_min(P##_view view); \
+    ICE_ARR_API  T              ICE_ARR_CALLCONV  P##_view_max(P##_view view); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_view_to_array(P##_view view); \
+    \
+    ICE_ARR_API  ice_arr_stats  ICE_ARR_CALLCONV  P##_stats_of(P arr); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_from_array(ice_arr_array arr); \
+    ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  P##_to_array(P arr);
+
+// Save/load of typed arrays, Declared separately so it's left out with ICE_ARR_NO_FILE
+#define ICE_ARR_DECLARE_TYPED_FILE(P) \
+    ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  P##_save(P arr, const char* path); \
+    ICE_ARR_API  P              ICE_ARR_CALLCONV  P##_load(const char* path);
+
 typedef void (*ice_arr_iter_func)(double n);
 typedef int (*ice_arr_res_func)(double a, double b);
+typedef int (*ice_arr_pred_func)(double n);
+typedef double (*ice_arr_map_func)(double n);
+typedef void (*ice_arr_iter_ctx_func)(void* ctx, int index, double n);
+typedef void (*ice_arr_chunk_func)(void* ctx, int index, double* arr, int len);
 
 typedef struct ice_arr_array {
     double* arr;
     int len;
-    int real_len;   // Value used for max allocated length (x1.5 array length, Increases by pushing elements)
+    int real_len;   // Value used for max allocated length (Grows by x1.5 when pushing elements beyond it)
 } ice_arr_array;
 
+// Circular buffer, Pushing/Popping at both ends and rotating doesn't move elements
+typedef struct ice_arr_ring {
+    double* arr;    // Ring content (Allocated by ICE_ARR_MALLOC)
+    int head;       // Index of first element in arr
+    int len;        // Ring length
+    int capacity;   // Allocation length
+} ice_arr_ring;
+
+// Bump allocator for short-lived arrays, Bind it with ice_arr_arena_bind and release everything allocated from it with ice_arr_arena_reset
+typedef struct ice_arr_arena {
+    struct ice_arr_arena_block* blocks;     // Memory blocks (Newest first)
+    size_t block_size;                      // Size of new blocks in bytes
+    void* last;                             // Last allocation (Can be resized in place)
+} ice_arr_arena;
+
+// Non-owning view over array elements, Doesn't allocate so it must not be freed and must not outlive array it views
+typedef struct ice_arr_view {
+    double* arr;    // Pointer to first element of view
+    int len;        // View length
+    int stride;     // Distance between elements (1 for contiguous elements, -1 for reversed elements)
+} ice_arr_view;
+
+// Array with inline storage, First ICE_ARR_SMALL_CAPACITY elements live inside struct so small arrays never allocate
+// NOTE: Elements pointer isn't stored (Inline elements move with struct), Use ice_arr_small_data to get it
+typedef struct ice_arr_small {
+    double* heap;                                   // Allocation once array outgrew inline storage (NULL before)
+    int len;                                        // Array length
+    int real_len;                                   // Max length before next allocation
+    double inline_arr[ICE_ARR_SMALL_CAPACITY];      // Inline storage
+} ice_arr_small;
+
+// Single-pass statistics accumulator (Welford), Accumulators of different threads can be merged with ice_arr_stats_merge
+typedef struct ice_arr_stats {
+    int64_t count;  // Count of pushed numbers (NaNs are ignored)
+    double mean;
+    double m2;      // Sum of squared differences from mean
+    double min;
+    double max;
+} ice_arr_stats;
+
+// Mergeable t-digest for approximate quantiles, Memory stays same no matter how many numbers are pushed
+typedef struct ice_arr_digest {
+    double* means;          // Centroid means from smaller to bigger (Allocated by ICE_ARR_MALLOC along with weights, scratch and buffer)
+    double* weights;        // Centroid weights
+    double* scratch;        // Space used while compressing
+    double* buf;            // Numbers pushed since last compression
+    int len;                // Centroids count
+    int capacity;           // Max centroids count
+    int buf_len;
+    int buf_capacity;
+    double compression;     // Accuracy parameter, Higher values keep more centroids
+    double total;           // Count of numbers in digest
+    double min;
+    double max;
+} ice_arr_digest;
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // ice_arr FUNCTIONS
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -237,11 +457,15 @@ ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_len(ice_arr_array arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_pop(ice_arr_array* arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_shift(ice_arr_array* arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_push(ice_arr_array* arr, double val);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_push_n(ice_arr_array* arr, double* vals, int count);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_reserve(ice_arr_array* arr, int capacity);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_shrink_to_fit(ice_arr_array* arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_rev(ice_arr_array* arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_free(ice_arr_array arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_fill(ice_arr_array* arr, double val);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_clear(ice_arr_array* arr);
 ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_sum(ice_arr_array arr);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_sum_with_mode(ice_arr_array arr, ice_arr_sum_mode mode);
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_first(ice_arr_array arr, int elems);
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_last(ice_arr_array arr, int elems);
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_concat(ice_arr_array a1, ice_arr_array a2);
@@ -265,11 +489,123 @@ ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_compact(ice_arr_array arr)
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_tail(ice_arr_array arr);
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_intersect(ice_arr_array a1, ice_arr_array a2);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_foreach(ice_arr_array arr, ice_arr_iter_func f);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_foreach_ctx(ice_arr_array arr, ice_arr_iter_ctx_func f, void* ctx);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_foreach_chunk(ice_arr_array arr, ice_arr_chunk_func f, void* ctx);
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_union(ice_arr_array a1, ice_arr_array a2);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_rotate(ice_arr_array* arr, int times);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_move(ice_arr_array* a1, int from_index, int elems_count, int to_index, ice_arr_array* a2);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort(ice_arr_array* arr);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort_asc(ice_arr_array* arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort_ex(ice_arr_array* arr, ice_arr_res_func f);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort_with_mode(ice_arr_array* arr, ice_arr_sort_mode mode);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_unique_with_mode(ice_arr_array arr, ice_arr_set_mode mode);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_except(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_except_with_mode(ice_arr_array a1, ice_arr_array a2, ice_arr_set_mode mode);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_intersect_with_mode(ice_arr_array a1, ice_arr_array a2, ice_arr_set_mode mode);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_union_with_mode(ice_arr_array a1, ice_arr_array a2, ice_arr_set_mode mode);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_remove_all(ice_arr_array* arr, double val);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_compact_inplace(ice_arr_array* arr);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_dedup_inplace(ice_arr_array* arr);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_dedup_inplace_with_mode(ice_arr_array* arr, ice_arr_set_mode mode);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_filter_inplace(ice_arr_array* arr, ice_arr_pred_func f);
+
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_lower_bound(ice_arr_array arr, double val);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_upper_bound(ice_arr_array arr, double val);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_sorted_includes(ice_arr_array arr, double val);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_sorted_intersect(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_sorted_union(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_eytzinger(ice_arr_array sorted);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_eytzinger_lower_bound(ice_arr_array eyt, double val);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_eytzinger_includes(ice_arr_array eyt, double val);
+
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_add(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_add_inplace(ice_arr_array* a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_mul(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_mul_inplace(ice_arr_array* a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_scale(ice_arr_array arr, double alpha);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_scale_inplace(ice_arr_array* arr, double alpha);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_axpy(double alpha, ice_arr_array x, ice_arr_array y);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_axpy_inplace(double alpha, ice_arr_array x, ice_arr_array* y);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_dot(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_map(ice_arr_array arr, ice_arr_map_func f);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_map_inplace(ice_arr_array* arr, ice_arr_map_func f);
+
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_of(ice_arr_array arr);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_first_view(ice_arr_array arr, int elems);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_last_view(ice_arr_array arr, int elems);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_sub_view(ice_arr_array arr, int from, int to);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_tail_view(ice_arr_array arr);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_sub(ice_arr_view view, int from, int to);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_step(ice_arr_view view, int step);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_view_get(ice_arr_view view, int index);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_view_len(ice_arr_view view);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_view_sum(ice_arr_view view);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_view_min(ice_arr_view view);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_view_max(ice_arr_view view);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_view_to_array(ice_arr_view view);
+
+ICE_ARR_API  ice_arr_ring   ICE_ARR_CALLCONV  ice_arr_ring_new(int capacity);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_ring_get(ice_arr_ring ring, int index);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_ring_set(ice_arr_ring* ring, int index, double val);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_ring_len(ice_arr_ring ring);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_ring_push_back(ice_arr_ring* ring, double val);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_ring_push_front(ice_arr_ring* ring, double val);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_ring_push_overwrite(ice_arr_ring* ring, double val);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_ring_pop_back(ice_arr_ring* ring);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_ring_pop_front(ice_arr_ring* ring);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_ring_rotate(ice_arr_ring* ring, int times);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_ring_to_array(ice_arr_ring ring);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_ring_free(ice_arr_ring ring);
+
+ICE_ARR_API  ice_arr_small  ICE_ARR_CALLCONV  ice_arr_small_new(void);
+ICE_ARR_API  double*        ICE_ARR_CALLCONV  ice_arr_small_data(ice_arr_small* arr);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_small_get(ice_arr_small* arr, int index);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_small_set(ice_arr_small* arr, int index, double val);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_small_len(ice_arr_small* arr);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_small_push(ice_arr_small* arr, double val);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_small_pop(ice_arr_small* arr);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_small_view(ice_arr_small* arr);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_small_to_array(ice_arr_small* arr);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_small_free(ice_arr_small* arr);
+
+ICE_ARR_API  ice_arr_arena  ICE_ARR_CALLCONV  ice_arr_arena_new(size_t block_size);
+ICE_ARR_API  ice_arr_arena* ICE_ARR_CALLCONV  ice_arr_arena_bind(ice_arr_arena* arena);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_arena_reset(ice_arr_arena* arena);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_arena_free(ice_arr_arena* arena);
+
+ICE_ARR_API  ice_arr_stats  ICE_ARR_CALLCONV  ice_arr_stats_new(void);
+ICE_ARR_API  ice_arr_stats  ICE_ARR_CALLCONV  ice_arr_stats_of(ice_arr_array arr);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_stats_push(ice_arr_stats* stats, double val);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_stats_push_n(ice_arr_stats* stats, double* vals, int count);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_stats_merge(ice_arr_stats* stats, ice_arr_stats other);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_stats_variance(ice_arr_stats stats);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_stats_stddev(ice_arr_stats stats);
+
+ICE_ARR_API  ice_arr_digest ICE_ARR_CALLCONV  ice_arr_digest_new(double compression);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_digest_push(ice_arr_digest* digest, double val);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_digest_push_n(ice_arr_digest* digest, double* vals, int count);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_digest_merge(ice_arr_digest* digest, ice_arr_digest* other);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_digest_quantile(ice_arr_digest* digest, double q);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_digest_free(ice_arr_digest digest);
+
+#if !defined(ICE_ARR_NO_FILE)
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_save(ice_arr_array arr, const char* path);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_load(const char* path);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_map_file(const char* path);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_unmap_file(ice_arr_view view);
+#endif
+
+ICE_ARR_DECLARE_TYPED(ice_arr_f32, float, double)
+ICE_ARR_DECLARE_TYPED(ice_arr_i32, int32_t, int64_t)
+ICE_ARR_DECLARE_TYPED(ice_arr_i64, int64_t, int64_t)
+ICE_ARR_DECLARE_TYPED(ice_arr_u8, uint8_t, uint64_t)
+
+#if !defined(ICE_ARR_NO_FILE)
+ICE_ARR_DECLARE_TYPED_FILE(ice_arr_f32)
+ICE_ARR_DECLARE_TYPED_FILE(ice_arr_i32)
+ICE_ARR_DECLARE_TYPED_FILE(ice_arr_i64)
+ICE_ARR_DECLARE_TYPED_FILE(ice_arr_u8)
+#endif
 
 #if defined(__cplusplus)
 }
@@ -280,503 +616,3788 @@ ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort_ex(ice_arr_array* arr
 ///////////////////////////////////////////////////////////////////////////////////////////
 #if defined(ICE_ARR_IMPL)
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_new(int len) {
-    ice_arr_array res = (ice_arr_array) {
-        (double*) ICE_ARR_MALLOC((len + (len / 2)) * sizeof(double)),
-        len,
-        len + (len / 2),
-    };
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if !defined(ICE_ARR_NO_FILE)
+#  include <stdio.h>
+#endif
+
+#if defined(ICE_ARR_MMAP_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#elif defined(ICE_ARR_MMAP_POSIX)
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
+#if defined(ICE_ARR_AVX)
+#  include <immintrin.h>
+#elif defined(ICE_ARR_SSE2)
+#  include <emmintrin.h>
+#elif defined(ICE_ARR_NEON)
+#  include <arm_neon.h>
+#endif
+
+// Reduction kernels, Each one uses 4 independent accumulators so additions/comparisons can overlap in CPU pipeline
+#if defined(ICE_ARR_AVX)
+static double ice_arr_sum_kernel(double* a, int n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+    double tmp[4];
+    double res;
+    int i = 0;
     
-    for (int i = 0; i < res.len; i++) {
-        res.arr[i] = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_add_pd(s0, _mm256_loadu_pd(a + i));
+        s1 = _mm256_add_pd(s1, _mm256_loadu_pd(a + i + 4));
+        s2 = _mm256_add_pd(s2, _mm256_loadu_pd(a + i + 8));
+        s3 = _mm256_add_pd(s3, _mm256_loadu_pd(a + i + 12));
     }
     
+    for (; i + 4 <= n; i += 4) s0 = _mm256_add_pd(s0, _mm256_loadu_pd(a + i));
+    
+    _mm256_storeu_pd(tmp, _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    res = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+    
+    for (; i < n; i++) res += a[i];
     return res;
 }
 
-ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_get(ice_arr_array arr, int index) {
-    if (index < arr.len) {
-        return arr.arr[index];
+// NOTE: Number comes first in min/max so NaN elements get ignored like scalar comparison does.
+static double ice_arr_min_kernel(double* a, int n, double init) {
+    __m256d m0 = _mm256_set1_pd(init), m1 = m0, m2 = m0, m3 = m0;
+    double tmp[4];
+    double res = init;
+    int i = 0;
+    
+    for (; i + 16 <= n; i += 16) {
+        m0 = _mm256_min_pd(_mm256_loadu_pd(a + i), m0);
+        m1 = _mm256_min_pd(_mm256_loadu_pd(a + i + 4), m1);
+        m2 = _mm256_min_pd(_mm256_loadu_pd(a + i + 8), m2);
+        m3 = _mm256_min_pd(_mm256_loadu_pd(a + i + 12), m3);
     }
     
-    return 0;
+    _mm256_storeu_pd(tmp, _mm256_min_pd(_mm256_min_pd(m0, m1), _mm256_min_pd(m2, m3)));
+    
+    for (int j = 0; j < 4; j++) if (tmp[j] < res) res = tmp[j];
+    for (; i < n; i++) if (a[i] < res) res = a[i];
+    return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_set(ice_arr_array* arr, int index, double val) {
-    if (index < arr->len) {
-        arr->arr[index] = val;
+static double ice_arr_max_kernel(double* a, int n, double init) {
+    __m256d m0 = _mm256_set1_pd(init), m1 = m0, m2 = m0, m3 = m0;
+    double tmp[4];
+    double res = init;
+    int i = 0;
+    
+    for (; i + 16 <= n; i += 16) {
+        m0 = _mm256_max_pd(_mm256_loadu_pd(a + i), m0);
+        m1 = _mm256_max_pd(_mm256_loadu_pd(a + i + 4), m1);
+        m2 = _mm256_max_pd(_mm256_loadu_pd(a + i + 8), m2);
+        m3 = _mm256_max_pd(_mm256_loadu_pd(a + i + 12), m3);
     }
+    
+    _mm256_storeu_pd(tmp, _mm256_max_pd(_mm256_max_pd(m0, m1), _mm256_max_pd(m2, m3)));
+    
+    for (int j = 0; j < 4; j++) if (tmp[j] > res) res = tmp[j];
+    for (; i < n; i++) if (a[i] > res) res = a[i];
+    return res;
 }
 
-ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_len(ice_arr_array arr) {
-    return arr.len;
-}
-
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_pop(ice_arr_array* arr) {
-    arr->len--;
-    //arr->arr[arr->len - 1] = 0;
-}
-
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_shift(ice_arr_array* arr) {
-    arr->len--;
+static int ice_arr_matches_kernel(double* a, int n, double val) {
+    __m256d v = _mm256_set1_pd(val);
+    int c0 = 0, c1 = 0;
+    int i = 0;
     
-    for (int i = 1; i < arr->len + 1; i++) {
-        arr->arr[i - 1] = arr->arr[i];
+    for (; i + 8 <= n; i += 8) {
+        int m0 = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i), v, _CMP_EQ_OQ));
+        int m1 = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i + 4), v, _CMP_EQ_OQ));
+        c0 += (m0 & 1) + ((m0 >> 1) & 1) + ((m0 >> 2) & 1) + (m0 >> 3);
+        c1 += (m1 & 1) + ((m1 >> 1) & 1) + ((m1 >> 2) & 1) + (m1 >> 3);
     }
+    
+    for (; i < n; i++) if (a[i] == val) c0++;
+    return c0 + c1;
 }
-
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_push(ice_arr_array* arr, double val) {
-    if (arr->len++ < arr->real_len) {
-        arr->arr[arr->len - 1] = val;
-    } else {
-        ICE_ARR_REALLOC(arr->arr, (arr->real_len + (arr->real_len / 2)) * sizeof(double));
-        arr->arr[arr->len - 1] = val;
-        arr->real_len += (arr->real_len / 2);
+#elif defined(ICE_ARR_SSE2)
+static double ice_arr_sum_kernel(double* a, int n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+    double tmp[2];
+    double res;
+    int i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm_add_pd(s0, _mm_loadu_pd(a + i));
+        s1 = _mm_add_pd(s1, _mm_loadu_pd(a + i + 2));
+        s2 = _mm_add_pd(s2, _mm_loadu_pd(a + i + 4));
+        s3 = _mm_add_pd(s3, _mm_loadu_pd(a + i + 6));
     }
+    
+    _mm_storeu_pd(tmp, _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+    res = tmp[0] + tmp[1];
+    
+    for (; i < n; i++) res += a[i];
+    return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_swap(double *a, double *b) {
-    double tmp = *a;
-    *a = *b;
-    *b = tmp;
-}
-
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rev(ice_arr_array* arr) {
-    for (int i = 0; i < arr->len / 2; i++) {
-        ice_arr_swap(arr->arr + i, arr->arr + arr->len - 1 - i);
+// NOTE: Number comes first in min/max so NaN elements get ignored like scalar comparison does.
+static double ice_arr_min_kernel(double* a, int n, double init) {
+    __m128d m0 = _mm_set1_pd(init), m1 = m0, m2 = m0, m3 = m0;
+    double tmp[2];
+    double res = init;
+    int i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        m0 = _mm_min_pd(_mm_loadu_pd(a + i), m0);
+        m1 = _mm_min_pd(_mm_loadu_pd(a + i + 2), m1);
+        m2 = _mm_min_pd(_mm_loadu_pd(a + i + 4), m2);
+        m3 = _mm_min_pd(_mm_loadu_pd(a + i + 6), m3);
     }
+    
+    _mm_storeu_pd(tmp, _mm_min_pd(_mm_min_pd(m0, m1), _mm_min_pd(m2, m3)));
+    
+    for (int j = 0; j < 2; j++) if (tmp[j] < res) res = tmp[j];
+    for (; i < n; i++) if (a[i] < res) res = a[i];
+    return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_free(ice_arr_array arr) {
-    ICE_ARR_FREE(arr.arr);
-}
-
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_fill(ice_arr_array* arr, double val) {
-    for (int i = 0; i < arr->len; i++) {
-        arr->arr[i] = val;
+static double ice_arr_max_kernel(double* a, int n, double init) {
+    __m128d m0 = _mm_set1_pd(init), m1 = m0, m2 = m0, m3 = m0;
+    double tmp[2];
+    double res = init;
+    int i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        m0 = _mm_max_pd(_mm_loadu_pd(a + i), m0);
+        m1 = _mm_max_pd(_mm_loadu_pd(a + i + 2), m1);
+        m2 = _mm_max_pd(_mm_loadu_pd(a + i + 4), m2);
+        m3 = _mm_max_pd(_mm_loadu_pd(a + i + 6), m3);
     }
+    
+    _mm_storeu_pd(tmp, _mm_max_pd(_mm_max_pd(m0, m1), _mm_max_pd(m2, m3)));
+    
+    for (int j = 0; j < 2; j++) if (tmp[j] > res) res = tmp[j];
+    for (; i < n; i++) if (a[i] > res) res = a[i];
+    return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_clear(ice_arr_array* arr) {
-    for (int i = 0; i < arr->len; i++) {
-        arr->arr[i] = 0;
+// Comparison masks are all bits set (-1) on match, So subtracting them counts matches per lane
+static int ice_arr_matches_kernel(double* a, int n, double val) {
+    __m128d v = _mm_set1_pd(val);
+    __m128i c0 = _mm_setzero_si128(), c1 = c0;
+    int64_t tmp[2];
+    int res;
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        c0 = _mm_sub_epi64(c0, _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(a + i), v)));
+        c1 = _mm_sub_epi64(c1, _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(a + i + 2), v)));
     }
+    
+    _mm_storeu_si128((__m128i*) tmp, _mm_add_epi64(c0, c1));
+    res = (int) (tmp[0] + tmp[1]);
+    
+    for (; i < n; i++) if (a[i] == val) res++;
+    return res;
 }
-
-ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sum(ice_arr_array arr) {
-    double res = 0;
+#elif defined(ICE_ARR_NEON)
+static double ice_arr_sum_kernel(double* a, int n) {
+    float64x2_t s0 = vdupq_n_f64(0), s1 = s0, s2 = s0, s3 = s0;
+    double res;
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        res += arr.arr[i];
+    for (; i + 8 <= n; i += 8) {
+        s0 = vaddq_f64(s0, vld1q_f64(a + i));
+        s1 = vaddq_f64(s1, vld1q_f64(a + i + 2));
+        s2 = vaddq_f64(s2, vld1q_f64(a + i + 4));
+        s3 = vaddq_f64(s3, vld1q_f64(a + i + 6));
     }
     
+    res = vaddvq_f64(vaddq_f64(vaddq_f64(s0, s1), vaddq_f64(s2, s3)));
+    
+    for (; i < n; i++) res += a[i];
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_first(ice_arr_array arr, int elems) {
-    ice_arr_array res = ice_arr_new((elems <= 1) ? 1 : elems);
+// NOTE: vminnmq/vmaxnmq return the number when other operand is NaN, So NaN elements get ignored like scalar comparison does.
+static double ice_arr_min_kernel(double* a, int n, double init) {
+    float64x2_t m0 = vdupq_n_f64(init), m1 = m0, m2 = m0, m3 = m0;
+    double res;
+    int i = 0;
     
-    for (int i = 0; i < res.len; i++) {
-        res.arr[i] = arr.arr[i];
+    for (; i + 8 <= n; i += 8) {
+        m0 = vminnmq_f64(m0, vld1q_f64(a + i));
+        m1 = vminnmq_f64(m1, vld1q_f64(a + i + 2));
+        m2 = vminnmq_f64(m2, vld1q_f64(a + i + 4));
+        m3 = vminnmq_f64(m3, vld1q_f64(a + i + 6));
     }
     
+    res = vminnmvq_f64(vminnmq_f64(vminnmq_f64(m0, m1), vminnmq_f64(m2, m3)));
+    
+    for (; i < n; i++) if (a[i] < res) res = a[i];
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_last(ice_arr_array arr, int elems) {
-    ice_arr_array res = ice_arr_new((elems <= 1) ? 1 : elems);
+static double ice_arr_max_kernel(double* a, int n, double init) {
+    float64x2_t m0 = vdupq_n_f64(init), m1 = m0, m2 = m0, m3 = m0;
+    double res;
+    int i = 0;
     
-    for (int i = 0; i < res.len; i++) {
-        res.arr[i] = arr.arr[(arr.len - 1) - i];
+    for (; i + 8 <= n; i += 8) {
+        m0 = vmaxnmq_f64(m0, vld1q_f64(a + i));
+        m1 = vmaxnmq_f64(m1, vld1q_f64(a + i + 2));
+        m2 = vmaxnmq_f64(m2, vld1q_f64(a + i + 4));
+        m3 = vmaxnmq_f64(m3, vld1q_f64(a + i + 6));
     }
     
+    res = vmaxnmvq_f64(vmaxnmq_f64(vmaxnmq_f64(m0, m1), vmaxnmq_f64(m2, m3)));
+    
+    for (; i < n; i++) if (a[i] > res) res = a[i];
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_concat(ice_arr_array a1, ice_arr_array a2) {
-    int idx = 0;
-    
-    ice_arr_array res = ice_arr_new(a1.len + a2.len);
+// Comparison masks are all bits set (-1) on match, So subtracting them counts matches per lane
+static int ice_arr_matches_kernel(double* a, int n, double val) {
+    float64x2_t v = vdupq_n_f64(val);
+    uint64x2_t c0 = vdupq_n_u64(0), c1 = c0;
+    int res;
+    int i = 0;
     
-    for (int i = 0; i < a1.len; i++) {
-        res.arr[idx + i] = a1.arr[i];
+    for (; i + 4 <= n; i += 4) {
+        c0 = vsubq_u64(c0, vceqq_f64(vld1q_f64(a + i), v));
+        c1 = vsubq_u64(c1, vceqq_f64(vld1q_f64(a + i + 2), v));
     }
     
-    idx += a1.len;
-    
-    for (int i = 0; i < a2.len; i++) {
-        res.arr[idx + i] = a2.arr[i];
-    }
+    res = (int) vaddvq_u64(vaddq_u64(c0, c1));
     
+    for (; i < n; i++) if (a[i] == val) res++;
     return res;
 }
-
-ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_match(ice_arr_array a1, ice_arr_array a2) {
-    int matches = 0;
+#else
+static double ice_arr_sum_kernel(double* a, int n) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i = 0;
     
-    if (a1.len != a2.len) {
-        return ICE_ARR_FALSE;
-    }
-        
-    for (int i = 0; i < a1.len; i++) {
-        if (a1.arr[i] == a2.arr[i]) matches++;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i];
+        s1 += a[i + 1];
+        s2 += a[i + 2];
+        s3 += a[i + 3];
     }
     
-    return (matches == a1.len) ? ICE_ARR_TRUE : ICE_ARR_FALSE;
+    for (; i < n; i++) s0 += a[i];
+    return (s0 + s1) + (s2 + s3);
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_sub(ice_arr_array arr, int from, int to) {
-    ice_arr_array res = ice_arr_new((from - to) + 1);
+static double ice_arr_min_kernel(double* a, int n, double init) {
+    double m0 = init, m1 = init, m2 = init, m3 = init;
+    int i = 0;
     
-    int count = 0;
-    for (int i = from; i <= to; i++) {
-        res.arr[count] = arr.arr[i];
-        count++;
+    for (; i + 4 <= n; i += 4) {
+        if (a[i] < m0) m0 = a[i];
+        if (a[i + 1] < m1) m1 = a[i + 1];
+        if (a[i + 2] < m2) m2 = a[i + 2];
+        if (a[i + 3] < m3) m3 = a[i + 3];
     }
     
-    return res;
+    for (; i < n; i++) if (a[i] < m0) m0 = a[i];
+    
+    if (m1 < m0) m0 = m1;
+    if (m3 < m2) m2 = m3;
+    return (m2 < m0) ? m2 : m0;
 }
 
-ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_includes(ice_arr_array arr, double val) {
-    ice_arr_bool res = ICE_ARR_FALSE;
+static double ice_arr_max_kernel(double* a, int n, double init) {
+    double m0 = init, m1 = init, m2 = init, m3 = init;
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) {
-            res = ICE_ARR_TRUE;
-            break;
-        }
+    for (; i + 4 <= n; i += 4) {
+        if (a[i] > m0) m0 = a[i];
+        if (a[i + 1] > m1) m1 = a[i + 1];
+        if (a[i + 2] > m2) m2 = a[i + 2];
+        if (a[i + 3] > m3) m3 = a[i + 3];
     }
     
-    return res;
+    for (; i < n; i++) if (a[i] > m0) m0 = a[i];
+    
+    if (m1 > m0) m0 = m1;
+    if (m3 > m2) m2 = m3;
+    return (m2 > m0) ? m2 : m0;
 }
 
-ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_matches(ice_arr_array arr, double val) {
-    int matches = 0;
+static int ice_arr_matches_kernel(double* a, int n, double val) {
+    int c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) matches++;
+    for (; i + 4 <= n; i += 4) {
+        c0 += (a[i] == val);
+        c1 += (a[i + 1] == val);
+        c2 += (a[i + 2] == val);
+        c3 += (a[i + 3] == val);
     }
     
-    return matches;
+    for (; i < n; i++) c0 += (a[i] == val);
+    return c0 + c1 + c2 + c3;
 }
+#endif
 
-ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_first_index(ice_arr_array arr, double val) {
-    int occurence = 0;
+// Element-wise kernels, dst can be same pointer as a (or y) for in-place operations
+#if defined(ICE_ARR_AVX)
+#  if defined(__FMA__)
+#    define ICE_ARR_FMADD_PD(a, b, c) _mm256_fmadd_pd(a, b, c)
+#  else
+#    define ICE_ARR_FMADD_PD(a, b, c) _mm256_add_pd(_mm256_mul_pd(a, b), c)
+#  endif
+
+static void ice_arr_add_kernel(double* dst, double* a, double* b, int n) {
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) {
-            occurence = i;
-            break;
-        }
+    for (; i + 8 <= n; i += 8) {
+        __m256d r0 = _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        __m256d r1 = _mm256_add_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+        _mm256_storeu_pd(dst + i, r0);
+        _mm256_storeu_pd(dst + i + 4, r1);
     }
     
-    return occurence;
+    for (; i < n; i++) dst[i] = a[i] + b[i];
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rem(ice_arr_array* arr, int index) {
-    if (index < arr->len) {
-        arr->len--;
+static void ice_arr_mul_kernel(double* dst, double* a, double* b, int n) {
+    int i = 0;
     
-        for (int i = index; i < arr->len + 1; i++) {
-            arr->arr[i] = arr->arr[i + 1];
-        }
+    for (; i + 8 <= n; i += 8) {
+        __m256d r0 = _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        __m256d r1 = _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+        _mm256_storeu_pd(dst + i, r0);
+        _mm256_storeu_pd(dst + i + 4, r1);
     }
+    
+    for (; i < n; i++) dst[i] = a[i] * b[i];
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_without(ice_arr_array arr, double val) {
-    int matches = 0;
-    int count   = 0;
+static void ice_arr_scale_kernel(double* dst, double* a, double alpha, int n) {
+    __m256d v = _mm256_set1_pd(alpha);
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) matches++;
+    for (; i + 8 <= n; i += 8) {
+        __m256d r0 = _mm256_mul_pd(_mm256_loadu_pd(a + i), v);
+        __m256d r1 = _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), v);
+        _mm256_storeu_pd(dst + i, r0);
+        _mm256_storeu_pd(dst + i + 4, r1);
     }
     
-    ice_arr_array res = ice_arr_new(arr.len - matches);
+    for (; i < n; i++) dst[i] = a[i] * alpha;
+}
+
+static void ice_arr_axpy_kernel(double* y, double alpha, double* x, int n) {
+    __m256d v = _mm256_set1_pd(alpha);
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] != val) {
-            res.arr[count] = arr.arr[i];
-            count++;
-        }
+    for (; i + 8 <= n; i += 8) {
+        __m256d r0 = ICE_ARR_FMADD_PD(v, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        __m256d r1 = ICE_ARR_FMADD_PD(v, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+        _mm256_storeu_pd(y + i, r0);
+        _mm256_storeu_pd(y + i + 4, r1);
     }
     
-    return res;
+    for (; i < n; i++) y[i] += alpha * x[i];
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_clone(ice_arr_array arr, int n) {
-    int count = 0;
-    ice_arr_array res = ice_arr_new(arr.len * n);
+static double ice_arr_dot_kernel(double* a, double* b, int n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+    double tmp[4];
+    double res;
+    int i = 0;
     
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < arr.len; j++) {
-            res.arr[j + count] = arr.arr[j];
-        }
-        
-        count += arr.len;
+    for (; i + 16 <= n; i += 16) {
+        s0 = ICE_ARR_FMADD_PD(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+        s1 = ICE_ARR_FMADD_PD(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), s1);
+        s2 = ICE_ARR_FMADD_PD(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), s2);
+        s3 = ICE_ARR_FMADD_PD(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), s3);
     }
     
+    _mm256_storeu_pd(tmp, _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    res = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+    
+    for (; i < n; i++) res += a[i] * b[i];
     return res;
 }
-
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_rest(ice_arr_array arr, int index) {
-    ice_arr_array res = ice_arr_new(arr.len - 1);
+#elif defined(ICE_ARR_SSE2)
+static void ice_arr_add_kernel(double* dst, double* a, double* b, int n) {
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (!(i == index)) {
-            res.arr[i] = arr.arr[i];
-        }
+    for (; i + 4 <= n; i += 4) {
+        __m128d r0 = _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+        __m128d r1 = _mm_add_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2));
+        _mm_storeu_pd(dst + i, r0);
+        _mm_storeu_pd(dst + i + 2, r1);
     }
     
-    return res;
+    for (; i < n; i++) dst[i] = a[i] + b[i];
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_unique(ice_arr_array arr) {
-    int len = 0;
-    int count = 0;
+static void ice_arr_mul_kernel(double* dst, double* a, double* b, int n) {
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (ice_arr_matches(arr, arr.arr[i]) == 1) {
-            len++;
-        }
+    for (; i + 4 <= n; i += 4) {
+        __m128d r0 = _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+        __m128d r1 = _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2));
+        _mm_storeu_pd(dst + i, r0);
+        _mm_storeu_pd(dst + i + 2, r1);
     }
     
-    ice_arr_array res = ice_arr_new(len);
+    for (; i < n; i++) dst[i] = a[i] * b[i];
+}
+
+static void ice_arr_scale_kernel(double* dst, double* a, double alpha, int n) {
+    __m128d v = _mm_set1_pd(alpha);
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (ice_arr_matches(arr, arr.arr[i]) == 1) {
-            res.arr[count] = arr.arr[i];
-            count++;
-        }
+    for (; i + 4 <= n; i += 4) {
+        __m128d r0 = _mm_mul_pd(_mm_loadu_pd(a + i), v);
+        __m128d r1 = _mm_mul_pd(_mm_loadu_pd(a + i + 2), v);
+        _mm_storeu_pd(dst + i, r0);
+        _mm_storeu_pd(dst + i + 2, r1);
     }
     
-    return res;
+    for (; i < n; i++) dst[i] = a[i] * alpha;
 }
 
-ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_last_index(ice_arr_array arr, double val) {
-    int occurence = 0;
+static void ice_arr_axpy_kernel(double* y, double alpha, double* x, int n) {
+    __m128d v = _mm_set1_pd(alpha);
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) {
-            if (i >= occurence) {
-                occurence = i;
-            }
-        }
+    for (; i + 4 <= n; i += 4) {
+        __m128d r0 = _mm_add_pd(_mm_mul_pd(v, _mm_loadu_pd(x + i)), _mm_loadu_pd(y + i));
+        __m128d r1 = _mm_add_pd(_mm_mul_pd(v, _mm_loadu_pd(x + i + 2)), _mm_loadu_pd(y + i + 2));
+        _mm_storeu_pd(y + i, r0);
+        _mm_storeu_pd(y + i + 2, r1);
     }
     
-    return occurence;
+    for (; i < n; i++) y[i] += alpha * x[i];
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_unshift(ice_arr_array arr, double val) {
-    ice_arr_array res = ice_arr_new(arr.len + 1);
-    arr.arr[0] = val;
+static double ice_arr_dot_kernel(double* a, double* b, int n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = s0, s2 = s0, s3 = s0;
+    double tmp[2];
+    double res;
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        res.arr[i + 1] = arr.arr[i];
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+        s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
     }
     
+    _mm_storeu_pd(tmp, _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+    res = tmp[0] + tmp[1];
+    
+    for (; i < n; i++) res += a[i] * b[i];
     return res;
 }
-
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_diff(ice_arr_array a1, ice_arr_array a2) {
-    int len = 0;
-    int count = 0;
+#elif defined(ICE_ARR_NEON)
+static void ice_arr_add_kernel(double* dst, double* a, double* b, int n) {
+    int i = 0;
     
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) == 1) {
-            len++;
-        }
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t r0 = vaddq_f64(vld1q_f64(a + i), vld1q_f64(b + i));
+        float64x2_t r1 = vaddq_f64(vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+        vst1q_f64(dst + i, r0);
+        vst1q_f64(dst + i + 2, r1);
     }
     
-    ice_arr_array res = ice_arr_new(len);
+    for (; i < n; i++) dst[i] = a[i] + b[i];
+}
+
+static void ice_arr_mul_kernel(double* dst, double* a, double* b, int n) {
+    int i = 0;
     
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) == 1) {
-            res.arr[count] = a1.arr[i];
-            count++;
-        }
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t r0 = vmulq_f64(vld1q_f64(a + i), vld1q_f64(b + i));
+        float64x2_t r1 = vmulq_f64(vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+        vst1q_f64(dst + i, r0);
+        vst1q_f64(dst + i + 2, r1);
     }
     
-    return res;
+    for (; i < n; i++) dst[i] = a[i] * b[i];
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_range(int i) {
-    ice_arr_array res = ice_arr_new(i);
+static void ice_arr_scale_kernel(double* dst, double* a, double alpha, int n) {
+    float64x2_t v = vdupq_n_f64(alpha);
+    int i = 0;
     
-    for (int j = 0; j < i; j++) {
-        res.arr[j] = i;
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t r0 = vmulq_f64(vld1q_f64(a + i), v);
+        float64x2_t r1 = vmulq_f64(vld1q_f64(a + i + 2), v);
+        vst1q_f64(dst + i, r0);
+        vst1q_f64(dst + i + 2, r1);
     }
     
+    for (; i < n; i++) dst[i] = a[i] * alpha;
+}
+
+// NOTE: vfmaq_f64(c, a, b) computes c + a * b with single rounding.
+static void ice_arr_axpy_kernel(double* y, double alpha, double* x, int n) {
+    float64x2_t v = vdupq_n_f64(alpha);
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t r0 = vfmaq_f64(vld1q_f64(y + i), v, vld1q_f64(x + i));
+        float64x2_t r1 = vfmaq_f64(vld1q_f64(y + i + 2), v, vld1q_f64(x + i + 2));
+        vst1q_f64(y + i, r0);
+        vst1q_f64(y + i + 2, r1);
+    }
+    
+    for (; i < n; i++) y[i] += alpha * x[i];
+}
+
+static double ice_arr_dot_kernel(double* a, double* b, int n) {
+    float64x2_t s0 = vdupq_n_f64(0), s1 = s0, s2 = s0, s3 = s0;
+    double res;
+    int i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        s0 = vfmaq_f64(s0, vld1q_f64(a + i), vld1q_f64(b + i));
+        s1 = vfmaq_f64(s1, vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+        s2 = vfmaq_f64(s2, vld1q_f64(a + i + 4), vld1q_f64(b + i + 4));
+        s3 = vfmaq_f64(s3, vld1q_f64(a + i + 6), vld1q_f64(b + i + 6));
+    }
+    
+    res = vaddvq_f64(vaddq_f64(vaddq_f64(s0, s1), vaddq_f64(s2, s3)));
+    
+    for (; i < n; i++) res += a[i] * b[i];
+    return res;
+}
+#else
+static void ice_arr_add_kernel(double* dst, double* a, double* b, int n) {
+    for (int i = 0; i < n; i++) dst[i] = a[i] + b[i];
+}
+
+static void ice_arr_mul_kernel(double* dst, double* a, double* b, int n) {
+    for (int i = 0; i < n; i++) dst[i] = a[i] * b[i];
+}
+
+static void ice_arr_scale_kernel(double* dst, double* a, double alpha, int n) {
+    for (int i = 0; i < n; i++) dst[i] = a[i] * alpha;
+}
+
+static void ice_arr_axpy_kernel(double* y, double alpha, double* x, int n) {
+    for (int i = 0; i < n; i++) y[i] += alpha * x[i];
+}
+
+static double ice_arr_dot_kernel(double* a, double* b, int n) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    
+    for (; i < n; i++) s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+#endif
+
+// Neumaier variant of Kahan summation, Keeps error bounded independently of array length
+// NOTE: Compiling with -ffast-math (or /fp:fast) may optimize compensation away!
+static double ice_arr_sum_kahan(double* a, int n) {
+    double sum = 0;
+    double c = 0;
+    
+    for (int i = 0; i < n; i++) {
+        double t = sum + a[i];
+        
+        if (fabs(sum) >= fabs(a[i])) {
+            c += (sum - t) + a[i];
+        } else {
+            c += (a[i] - t) + sum;
+        }
+        
+        sum = t;
+    }
+    
+    return sum + c;
+}
+
+// Pairwise summation, Error grows O(log n) and leaves are summed by SIMD kernel
+static double ice_arr_sum_pairwise(double* a, int n) {
+    if (n <= 256) {
+        return ice_arr_sum_kernel(a, n);
+    }
+    
+    return ice_arr_sum_pairwise(a, n / 2) + ice_arr_sum_pairwise(a + n / 2, n - n / 2);
+}
+
+#if defined(ICE_ARR_PARALLEL)
+// Parallel execution, Arrays are split into fixed-size chunks (Independent of threads count) and partial results are reduced in chunk order so results are same on every machine.
+#include <pthread.h>
+#include "ice_cpu.h"
+
+typedef void (*ice_arr_task_func)(void* ctx, int index);
+
+static struct {
+    pthread_mutex_t lock;       // Protects job state below
+    pthread_mutex_t busy;       // Held by thread running a job, Other callers run serially instead of waiting
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    int threads_count;
+    ice_arr_task_func func;
+    void* ctx;
+    int tasks;
+    int next;
+    int finished;
+} ice_arr_pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, 1, NULL, NULL, 0, 0, 0 };
+
+static pthread_once_t ice_arr_pool_once = PTHREAD_ONCE_INIT;
+
+static void* ice_arr_pool_worker(void* arg) {
+    (void) arg;
+    pthread_mutex_lock(&ice_arr_pool.lock);
+    
+    for (;;) {
+        ice_arr_task_func func;
+        void* ctx;
+        int index;
+        
+        while (ice_arr_pool.next >= ice_arr_pool.tasks) {
+            pthread_cond_wait(&ice_arr_pool.wake, &ice_arr_pool.lock);
+        }
+        
+        func = ice_arr_pool.func;
+        ctx = ice_arr_pool.ctx;
+        index = ice_arr_pool.next++;
+        pthread_mutex_unlock(&ice_arr_pool.lock);
+        
+        func(ctx, index);
+        
+        pthread_mutex_lock(&ice_arr_pool.lock);
+        if (++ice_arr_pool.finished == ice_arr_pool.tasks) pthread_cond_signal(&ice_arr_pool.done);
+    }
+    
+    return NULL;
+}
+
+static void ice_arr_pool_init(void) {
+    int count = (int) ice_cpu_cores_count();
+    
+    if (count > ICE_ARR_PARALLEL_MAX_THREADS) count = ICE_ARR_PARALLEL_MAX_THREADS;
+    
+    // Thread that runs a job works too, So only (count - 1) workers are created
+    for (int i = 1; i < count; i++) {
+        pthread_t thread;
+        
+        if (pthread_create(&thread, NULL, ice_arr_pool_worker, NULL) != 0) break;
+        
+        pthread_detach(thread);
+        ice_arr_pool.threads_count++;
+    }
+}
+
+// Runs func for each task index from 0 to (tasks - 1) across thread pool and returns once all of them finished
+static void ice_arr_parallel_run(ice_arr_task_func func, void* ctx, int tasks) {
+    pthread_once(&ice_arr_pool_once, ice_arr_pool_init);
+    
+    if (tasks <= 1 || ice_arr_pool.threads_count <= 1 || pthread_mutex_trylock(&ice_arr_pool.busy) != 0) {
+        for (int i = 0; i < tasks; i++) func(ctx, i);
+        return;
+    }
+    
+    pthread_mutex_lock(&ice_arr_pool.lock);
+    ice_arr_pool.func = func;
+    ice_arr_pool.ctx = ctx;
+    ice_arr_pool.tasks = tasks;
+    ice_arr_pool.next = 0;
+    ice_arr_pool.finished = 0;
+    pthread_cond_broadcast(&ice_arr_pool.wake);
+    
+    while (ice_arr_pool.next < tasks) {
+        int index = ice_arr_pool.next++;
+        pthread_mutex_unlock(&ice_arr_pool.lock);
+        func(ctx, index);
+        pthread_mutex_lock(&ice_arr_pool.lock);
+        ice_arr_pool.finished++;
+    }
+    
+    while (ice_arr_pool.finished < tasks) {
+        pthread_cond_wait(&ice_arr_pool.done, &ice_arr_pool.lock);
+    }
+    
+    ice_arr_pool.tasks = 0;
+    ice_arr_pool.next = 0;
+    pthread_mutex_unlock(&ice_arr_pool.lock);
+    pthread_mutex_unlock(&ice_arr_pool.busy);
+}
+
+static int ice_arr_parallel_chunks(int n) {
+    return (n + ICE_ARR_PARALLEL_CHUNK - 1) / ICE_ARR_PARALLEL_CHUNK;
+}
+
+typedef enum ice_arr_parallel_op {
+    ICE_ARR_PARALLEL_OP_FILL,
+    ICE_ARR_PARALLEL_OP_SUM,
+    ICE_ARR_PARALLEL_OP_MIN,
+    ICE_ARR_PARALLEL_OP_MAX,
+    ICE_ARR_PARALLEL_OP_MATCHES,
+    ICE_ARR_PARALLEL_OP_FOREACH,
+    ICE_ARR_PARALLEL_OP_SORT,
+} ice_arr_parallel_op;
+
+typedef struct ice_arr_parallel_ctx {
+    ice_arr_parallel_op op;
+    double* arr;
+    int len;
+    double val;
+    ice_arr_iter_func f;
+    double* partials;
+} ice_arr_parallel_ctx;
+
+static void ice_arr_sort_introsort(double* a, int n, ice_arr_res_func f);
+
+static void ice_arr_parallel_task(void* ctx, int index) {
+    ice_arr_parallel_ctx* c = (ice_arr_parallel_ctx*) ctx;
+    int from = index * ICE_ARR_PARALLEL_CHUNK;
+    int n = (c->len - from < ICE_ARR_PARALLEL_CHUNK) ? (c->len - from) : ICE_ARR_PARALLEL_CHUNK;
+    double* a = c->arr + from;
+    
+    switch (c->op) {
+        case ICE_ARR_PARALLEL_OP_FILL:
+            for (int i = 0; i < n; i++) a[i] = c->val;
+            break;
+        case ICE_ARR_PARALLEL_OP_SUM:
+            c->partials[index] = ice_arr_sum_kernel(a, n);
+            break;
+        case ICE_ARR_PARALLEL_OP_MIN:
+            c->partials[index] = ice_arr_min_kernel(a, n, HUGE_VAL);
+            break;
+        case ICE_ARR_PARALLEL_OP_MAX:
+            c->partials[index] = ice_arr_max_kernel(a, n, -HUGE_VAL);
+            break;
+        case ICE_ARR_PARALLEL_OP_MATCHES:
+            c->partials[index] = ice_arr_matches_kernel(a, n, c->val);
+            break;
+        case ICE_ARR_PARALLEL_OP_FOREACH:
+            for (int i = 0; i < n; i++) c->f(a[i]);
+            break;
+        case ICE_ARR_PARALLEL_OP_SORT:
+            ice_arr_sort_introsort(a, n, NULL);
+            break;
+    }
+}
+
+// Runs operation over array chunks, Returns ICE_ARR_FALSE if partial results buffer allocation failed (So caller runs serially)
+static ice_arr_bool ice_arr_parallel(ice_arr_parallel_op op, double* arr, int len, double val, ice_arr_iter_func f, double* res) {
+    ice_arr_parallel_ctx ctx = { op, arr, len, val, f, NULL };
+    int tasks = ice_arr_parallel_chunks(len);
+    
+    if (res != NULL) {
+        ctx.partials = (double*) ICE_ARR_MALLOC(tasks * sizeof(double));
+        if (ctx.partials == NULL) return ICE_ARR_FALSE;
+    }
+    
+    ice_arr_parallel_run(ice_arr_parallel_task, &ctx, tasks);
+    
+    // Reduce in chunk order so result doesn't depend on which thread finished first
+    if (res != NULL) {
+        *res = ctx.partials[0];
+        
+        for (int i = 1; i < tasks; i++) {
+            if (op == ICE_ARR_PARALLEL_OP_MIN) {
+                if (ctx.partials[i] < *res) *res = ctx.partials[i];
+            } else if (op == ICE_ARR_PARALLEL_OP_MAX) {
+                if (ctx.partials[i] > *res) *res = ctx.partials[i];
+            } else {
+                *res += ctx.partials[i];
+            }
+        }
+        
+        ICE_ARR_FREE(ctx.partials);
+    }
+    
+    return ICE_ARR_TRUE;
+}
+
+typedef struct ice_arr_parallel_merge_ctx {
+    double* src;
+    double* dst;
+    int len;
+    int width;
+} ice_arr_parallel_merge_ctx;
+
+// Merges 2 sorted runs [lo, lo + width) and [lo + width, lo + 2 * width) from src to dst
+static void ice_arr_parallel_merge_task(void* ctx, int index) {
+    ice_arr_parallel_merge_ctx* c = (ice_arr_parallel_merge_ctx*) ctx;
+    int lo = index * 2 * c->width;
+    int mid = (lo + c->width < c->len) ? (lo + c->width) : c->len;
+    int hi = (mid + c->width < c->len) ? (mid + c->width) : c->len;
+    int i = lo, j = mid, k = lo;
+    
+    while (i < mid && j < hi) {
+        c->dst[k++] = (c->src[j] < c->src[i]) ? c->src[j++] : c->src[i++];
+    }
+    
+    while (i < mid) c->dst[k++] = c->src[i++];
+    while (j < hi) c->dst[k++] = c->src[j++];
+}
+
+// Sorts chunks in parallel then merges them level by level, Returns ICE_ARR_FALSE if merge buffer allocation failed
+static ice_arr_bool ice_arr_parallel_sort(double* arr, int len) {
+    ice_arr_parallel_merge_ctx ctx;
+    double* buf = (double*) ICE_ARR_MALLOC(len * sizeof(double));
+    
+    if (buf == NULL) {
+        return ICE_ARR_FALSE;
+    }
+    
+    ice_arr_parallel(ICE_ARR_PARALLEL_OP_SORT, arr, len, 0, NULL, NULL);
+    
+    ctx.src = arr;
+    ctx.dst = buf;
+    ctx.len = len;
+    
+    for (ctx.width = ICE_ARR_PARALLEL_CHUNK; ctx.width < len; ctx.width *= 2) {
+        double* tmp;
+        
+        ice_arr_parallel_run(ice_arr_parallel_merge_task, &ctx, (len + 2 * ctx.width - 1) / (2 * ctx.width));
+        
+        tmp = ctx.src;
+        ctx.src = ctx.dst;
+        ctx.dst = tmp;
+    }
+    
+    if (ctx.src != arr) {
+        memcpy(arr, ctx.src, len * sizeof(double));
+    }
+    
+    ICE_ARR_FREE(buf);
+    return ICE_ARR_TRUE;
+}
+
+typedef struct ice_arr_parallel_foreach_ctx {
+    double* arr;
+    int len;
+    ice_arr_iter_ctx_func f;
+    ice_arr_chunk_func chunk_f;
+    void* ctx;
+} ice_arr_parallel_foreach_ctx;
+
+static void ice_arr_parallel_foreach_task(void* ctx, int index) {
+    ice_arr_parallel_foreach_ctx* c = (ice_arr_parallel_foreach_ctx*) ctx;
+    int from = index * ICE_ARR_PARALLEL_CHUNK;
+    int to = (c->len - from < ICE_ARR_PARALLEL_CHUNK) ? c->len : from + ICE_ARR_PARALLEL_CHUNK;
+    
+    if (c->chunk_f != NULL) {
+        for (int i = from; i < to; i += ICE_ARR_FOREACH_CHUNK) {
+            c->chunk_f(c->ctx, i, c->arr + i, (to - i < ICE_ARR_FOREACH_CHUNK) ? (to - i) : ICE_ARR_FOREACH_CHUNK);
+        }
+    } else {
+        for (int i = from; i < to; i++) c->f(c->ctx, i, c->arr[i]);
+    }
+}
+#endif
+
+// Arena allocator, While arena is bound to thread every array created by ice_arr is bump-allocated from it (Heap arrays growing meanwhile stay on heap)
+#if defined(_MSC_VER)
+#  define ICE_ARR_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#  define ICE_ARR_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+#  define ICE_ARR_THREAD_LOCAL __thread
+#else
+#  define ICE_ARR_THREAD_LOCAL
+#endif
+
+// Allocations are aligned to 16 bytes so SIMD loads stay aligned-friendly
+#define ICE_ARR_ARENA_ALIGN(sz) (((sz) + 15) & ~((size_t) 15))
+
+struct ice_arr_arena_block {
+    struct ice_arr_arena_block* next;
+    size_t size;
+    size_t used;
+    size_t pad;     // Keeps data 16-bytes aligned after header on 32-bit and 64-bit platforms
+};
+
+static ICE_ARR_THREAD_LOCAL ice_arr_arena* ice_arr_arena_bound = NULL;
+
+static char* ice_arr_arena_data(struct ice_arr_arena_block* block) {
+    return (char*) (block + 1);
+}
+
+static struct ice_arr_arena_block* ice_arr_arena_block_new(size_t size) {
+    struct ice_arr_arena_block* block = (struct ice_arr_arena_block*) ICE_ARR_MALLOC(sizeof(struct ice_arr_arena_block) + size);
+    
+    if (block != NULL) {
+        block->next = NULL;
+        block->size = size;
+        block->used = 0;
+    }
+    
+    return block;
+}
+
+// Returns ICE_ARR_TRUE if memory pointed by ptr is allocated from arena
+static ice_arr_bool ice_arr_arena_owns(ice_arr_arena* arena, void* ptr) {
+    for (struct ice_arr_arena_block* b = arena->blocks; b != NULL; b = b->next) {
+        char* data = ice_arr_arena_data(b);
+        if ((char*) ptr >= data && (char*) ptr < data + b->size) return ICE_ARR_TRUE;
+    }
+    
+    return ICE_ARR_FALSE;
+}
+
+static void* ice_arr_arena_alloc(ice_arr_arena* arena, size_t size) {
+    struct ice_arr_arena_block* b = arena->blocks;
+    void* res;
+    
+    size = ICE_ARR_ARENA_ALIGN(size);
+    
+    // New blocks are pushed to front of list, So first block is the one with free space
+    if (b == NULL || b->size - b->used < size) {
+        size_t block_size = (size > arena->block_size) ? size : arena->block_size;
+        
+        b = ice_arr_arena_block_new(block_size);
+        if (b == NULL) return NULL;
+        
+        b->next = arena->blocks;
+        arena->blocks = b;
+    }
+    
+    res = ice_arr_arena_data(b) + b->used;
+    b->used += size;
+    arena->last = res;
+    
+    return res;
+}
+
+static void* ice_arr_mem_calloc(size_t size) {
+    void* res;
+    
+    if (ice_arr_arena_bound == NULL) {
+        return ICE_ARR_CALLOC(1, size);
+    }
+    
+    res = ice_arr_arena_alloc(ice_arr_arena_bound, size);
+    if (res != NULL) memset(res, 0, size);
+    
+    return res;
+}
+
+static void* ice_arr_mem_realloc(void* ptr, size_t old_size, size_t size) {
+    ice_arr_arena* arena = ice_arr_arena_bound;
+    void* res;
+    
+    // Arrays allocated on heap stay on heap, Only NULL and arena-owned pointers are bump-allocated
+    if (arena == NULL || (ptr != NULL && ice_arr_arena_owns(arena, ptr) == ICE_ARR_FALSE)) {
+        return ICE_ARR_REALLOC(ptr, size);
+    }
+    
+    // Last allocation can be resized in place
+    if (ptr != NULL && ptr == arena->last) {
+        struct ice_arr_arena_block* b = arena->blocks;
+        size_t offset = (char*) ptr - ice_arr_arena_data(b);
+        
+        if (offset + ICE_ARR_ARENA_ALIGN(size) <= b->size) {
+            b->used = offset + ICE_ARR_ARENA_ALIGN(size);
+            return ptr;
+        }
+    }
+    
+    if (ptr != NULL && size <= old_size) {
+        return ptr;
+    }
+    
+    res = ice_arr_arena_alloc(arena, size);
+    if (res == NULL) return NULL;
+    
+    if (ptr != NULL) {
+        memcpy(res, ptr, old_size);
+    }
+    
+    return res;
+}
+
+static void ice_arr_mem_free(void* ptr) {
+    if (ice_arr_arena_bound != NULL && ice_arr_arena_owns(ice_arr_arena_bound, ptr) == ICE_ARR_TRUE) {
+        return;
+    }
+    
+    ICE_ARR_FREE(ptr);
+}
+
+ICE_ARR_API ice_arr_arena ICE_ARR_CALLCONV ice_arr_arena_new(size_t block_size) {
+    ice_arr_arena res = { NULL, ICE_ARR_ARENA_ALIGN((block_size > 0) ? block_size : 65536), NULL };
+    res.blocks = ice_arr_arena_block_new(res.block_size);
+    return res;
+}
+
+ICE_ARR_API ice_arr_arena* ICE_ARR_CALLCONV ice_arr_arena_bind(ice_arr_arena* arena) {
+    ice_arr_arena* prev = ice_arr_arena_bound;
+    ice_arr_arena_bound = arena;
+    return prev;
+}
+
+// Releases all arrays allocated from arena at once, If arena needed multiple blocks they get merged into one so next use doesn't allocate
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_arena_reset(ice_arr_arena* arena) {
+    struct ice_arr_arena_block* b = arena->blocks;
+    
+    arena->last = NULL;
+    
+    if (b == NULL) return;
+    
+    if (b->next != NULL) {
+        size_t total = 0;
+        
+        while (b != NULL) {
+            struct ice_arr_arena_block* next = b->next;
+            total += b->size;
+            ICE_ARR_FREE(b);
+            b = next;
+        }
+        
+        arena->block_size = total;
+        arena->blocks = ice_arr_arena_block_new(total);
+        return;
+    }
+    
+    b->used = 0;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_arena_free(ice_arr_arena* arena) {
+    struct ice_arr_arena_block* b = arena->blocks;
+    
+    if (ice_arr_arena_bound == arena) {
+        ice_arr_arena_bound = NULL;
+    }
+    
+    while (b != NULL) {
+        struct ice_arr_arena_block* next = b->next;
+        ICE_ARR_FREE(b);
+        b = next;
+    }
+    
+    arena->blocks = NULL;
+    arena->last = NULL;
+}
+
+// Grows allocation of array so it can hold at least capacity elements, Growth is x1.5 to keep pushes amortized O(1).
+static ice_arr_bool ice_arr_grow(ice_arr_array* arr, int capacity) {
+    int new_len = arr->real_len + (arr->real_len / 2);
+    double* res;
+    
+    if (capacity <= arr->real_len) {
+        return ICE_ARR_TRUE;
+    }
+    
+    if (new_len < capacity) new_len = capacity;
+    if (new_len < ICE_ARR_MIN_CAPACITY) new_len = ICE_ARR_MIN_CAPACITY;
+    
+    res = (double*) ice_arr_mem_realloc(arr->arr, arr->real_len * sizeof(double), new_len * sizeof(double));
+    
+    if (res == NULL) {
+        return ICE_ARR_FALSE;
+    }
+    
+    arr->arr = res;
+    arr->real_len = new_len;
+    
+    return ICE_ARR_TRUE;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_new(int len) {
+    ice_arr_array res = (ice_arr_array) {
+        (double*) ice_arr_mem_calloc(((len > 0) ? len : 1) * sizeof(double)),
+        len,
+        len,
+    };
+    
+    if (res.arr == NULL) {
+        res.len = 0;
+        res.real_len = 0;
+    }
+    
+    return res;
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_get(ice_arr_array arr, int index) {
+    if (index < arr.len) {
+        return arr.arr[index];
+    }
+    
+    return 0;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_set(ice_arr_array* arr, int index, double val) {
+    if (index < arr->len) {
+        arr->arr[index] = val;
+    }
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_len(ice_arr_array arr) {
+    return arr.len;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_pop(ice_arr_array* arr) {
+    arr->len--;
+    //arr->arr[arr->len - 1] = 0;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_shift(ice_arr_array* arr) {
+    if (arr->len <= 0) return;
+    
+    arr->len--;
+    memmove(arr->arr, arr->arr + 1, arr->len * sizeof(double));
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_push(ice_arr_array* arr, double val) {
+    if (arr->len >= arr->real_len) {
+        if (ice_arr_grow(arr, arr->len + 1) == ICE_ARR_FALSE) return;
+    }
+    
+    arr->arr[arr->len++] = val;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_push_n(ice_arr_array* arr, double* vals, int count) {
+    if (count <= 0) return;
+    if (ice_arr_grow(arr, arr->len + count) == ICE_ARR_FALSE) return;
+    
+    memcpy(arr->arr + arr->len, vals, count * sizeof(double));
+    arr->len += count;
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_reserve(ice_arr_array* arr, int capacity) {
+    double* res;
+    
+    if (capacity <= arr->real_len) {
+        return ICE_ARR_TRUE;
+    }
+    
+    res = (double*) ice_arr_mem_realloc(arr->arr, arr->real_len * sizeof(double), capacity * sizeof(double));
+    
+    if (res == NULL) {
+        return ICE_ARR_FALSE;
+    }
+    
+    arr->arr = res;
+    arr->real_len = capacity;
+    
+    return ICE_ARR_TRUE;
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_shrink_to_fit(ice_arr_array* arr) {
+    int len = (arr->len > 0) ? arr->len : 1;
+    double* res;
+    
+    if (arr->real_len <= len) {
+        return ICE_ARR_TRUE;
+    }
+    
+    res = (double*) ice_arr_mem_realloc(arr->arr, arr->real_len * sizeof(double), len * sizeof(double));
+    
+    if (res == NULL) {
+        return ICE_ARR_FALSE;
+    }
+    
+    arr->arr = res;
+    arr->real_len = len;
+    
+    return ICE_ARR_TRUE;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_swap(double *a, double *b) {
+    double tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rev(ice_arr_array* arr) {
+    for (int i = 0; i < arr->len / 2; i++) {
+        ice_arr_swap(arr->arr + i, arr->arr + arr->len - 1 - i);
+    }
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_free(ice_arr_array arr) {
+    ice_arr_mem_free(arr.arr);
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_fill(ice_arr_array* arr, double val) {
+#if defined(ICE_ARR_PARALLEL)
+    if (arr->len >= ICE_ARR_PARALLEL_MIN) {
+        ice_arr_parallel(ICE_ARR_PARALLEL_OP_FILL, arr->arr, arr->len, val, NULL, NULL);
+        return;
+    }
+#endif
+    
+    for (int i = 0; i < arr->len; i++) {
+        arr->arr[i] = val;
+    }
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_clear(ice_arr_array* arr) {
+    ice_arr_fill(arr, 0);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sum(ice_arr_array arr) {
+    return ice_arr_sum_with_mode(arr, ICE_ARR_SUM_FAST);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sum_with_mode(ice_arr_array arr, ice_arr_sum_mode mode) {
+    if (mode == ICE_ARR_SUM_KAHAN) return ice_arr_sum_kahan(arr.arr, arr.len);
+    if (mode == ICE_ARR_SUM_PAIRWISE) return ice_arr_sum_pairwise(arr.arr, arr.len);
+    
+#if defined(ICE_ARR_PARALLEL)
+    if (arr.len >= ICE_ARR_PARALLEL_MIN) {
+        double res;
+        if (ice_arr_parallel(ICE_ARR_PARALLEL_OP_SUM, arr.arr, arr.len, 0, NULL, &res) == ICE_ARR_TRUE) return res;
+    }
+#endif
+    
+    return ice_arr_sum_kernel(arr.arr, arr.len);
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_first(ice_arr_array arr, int elems) {
+    ice_arr_array res = ice_arr_new(((elems <= 1) ? 1 : elems) > arr.len ? arr.len : ((elems <= 1) ? 1 : elems));
+    
+    for (int i = 0; i < res.len; i++) {
+        res.arr[i] = arr.arr[i];
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_last(ice_arr_array arr, int elems) {
+    ice_arr_array res = ice_arr_new(((elems <= 1) ? 1 : elems) > arr.len ? arr.len : ((elems <= 1) ? 1 : elems));
+    
+    for (int i = 0; i < res.len; i++) {
+        res.arr[i] = arr.arr[(arr.len - 1) - i];
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_concat(ice_arr_array a1, ice_arr_array a2) {
+    int idx = 0;
+    
+    ice_arr_array res = ice_arr_new(a1.len + a2.len);
+    
+    for (int i = 0; i < a1.len; i++) {
+        res.arr[idx + i] = a1.arr[i];
+    }
+    
+    idx += a1.len;
+    
+    for (int i = 0; i < a2.len; i++) {
+        res.arr[idx + i] = a2.arr[i];
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_match(ice_arr_array a1, ice_arr_array a2) {
+    int matches = 0;
+    
+    if (a1.len != a2.len) {
+        return ICE_ARR_FALSE;
+    }
+        
+    for (int i = 0; i < a1.len; i++) {
+        if (a1.arr[i] == a2.arr[i]) matches++;
+    }
+    
+    return (matches == a1.len) ? ICE_ARR_TRUE : ICE_ARR_FALSE;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_sub(ice_arr_array arr, int from, int to) {
+    ice_arr_array res;
+    
+    if (from < 0) from = 0;
+    if (to > arr.len - 1) to = arr.len - 1;
+    
+    res = ice_arr_new((from <= to) ? (to - from) + 1 : 0);
+    
+    if (res.len > 0) {
+        memcpy(res.arr, arr.arr + from, res.len * sizeof(double));
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_includes(ice_arr_array arr, double val) {
+    ice_arr_bool res = ICE_ARR_FALSE;
+    
+    for (int i = 0; i < arr.len; i++) {
+        if (arr.arr[i] == val) {
+            res = ICE_ARR_TRUE;
+            break;
+        }
+    }
+    
+    return res;
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_matches(ice_arr_array arr, double val) {
+#if defined(ICE_ARR_PARALLEL)
+    if (arr.len >= ICE_ARR_PARALLEL_MIN) {
+        double res;
+        if (ice_arr_parallel(ICE_ARR_PARALLEL_OP_MATCHES, arr.arr, arr.len, val, NULL, &res) == ICE_ARR_TRUE) return (int) res;
+    }
+#endif
+    
+    return ice_arr_matches_kernel(arr.arr, arr.len, val);
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_first_index(ice_arr_array arr, double val) {
+    int occurence = 0;
+    
+    for (int i = 0; i < arr.len; i++) {
+        if (arr.arr[i] == val) {
+            occurence = i;
+            break;
+        }
+    }
+    
+    return occurence;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rem(ice_arr_array* arr, int index) {
+    if (index >= 0 && index < arr->len) {
+        arr->len--;
+        memmove(arr->arr + index, arr->arr + index + 1, (arr->len - index) * sizeof(double));
+    }
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_without(ice_arr_array arr, double val) {
+    int matches = 0;
+    int count   = 0;
+    
+    for (int i = 0; i < arr.len; i++) {
+        if (arr.arr[i] == val) matches++;
+    }
+    
+    ice_arr_array res = ice_arr_new(arr.len - matches);
+    
+    for (int i = 0; i < arr.len; i++) {
+        if (arr.arr[i] != val) {
+            res.arr[count] = arr.arr[i];
+            count++;
+        }
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_clone(ice_arr_array arr, int n) {
+    int count = 0;
+    ice_arr_array res = ice_arr_new(arr.len * n);
+    
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < arr.len; j++) {
+            res.arr[j + count] = arr.arr[j];
+        }
+        
+        count += arr.len;
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_rest(ice_arr_array arr, int index) {
+    ice_arr_array res = ice_arr_new((arr.len > 1) ? arr.len - 1 : 0);
+    int count = 0;
+    
+    for (int i = 0; i < arr.len && count < res.len; i++) {
+        if (!(i == index)) {
+            res.arr[count] = arr.arr[i];
+            count++;
+        }
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_unique(ice_arr_array arr) {
+    return ice_arr_unique_with_mode(arr, ICE_ARR_SET_HASH);
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_last_index(ice_arr_array arr, double val) {
+    int occurence = 0;
+    
+    for (int i = 0; i < arr.len; i++) {
+        if (arr.arr[i] == val) {
+            if (i >= occurence) {
+                occurence = i;
+            }
+        }
+    }
+    
+    return occurence;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_unshift(ice_arr_array arr, double val) {
+    ice_arr_array res = ice_arr_new(arr.len + 1);
+    
+    if (res.len == arr.len + 1) {
+        res.arr[0] = val;
+        memcpy(res.arr + 1, arr.arr, arr.len * sizeof(double));
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_range(int i) {
+    ice_arr_array res = ice_arr_new(i);
+    
+    for (int j = 0; j < i; j++) {
+        res.arr[j] = j;
+    }
+    
+    return res;
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_min(ice_arr_array arr) {
+#if defined(ICE_ARR_PARALLEL)
+    if (arr.len >= ICE_ARR_PARALLEL_MIN) {
+        double res;
+        if (ice_arr_parallel(ICE_ARR_PARALLEL_OP_MIN, arr.arr, arr.len, 0, NULL, &res) == ICE_ARR_TRUE) return res;
+    }
+#endif
+    
+    return ice_arr_min_kernel(arr.arr, arr.len, HUGE_VAL);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_max(ice_arr_array arr) {
+#if defined(ICE_ARR_PARALLEL)
+    if (arr.len >= ICE_ARR_PARALLEL_MIN) {
+        double res;
+        if (ice_arr_parallel(ICE_ARR_PARALLEL_OP_MAX, arr.arr, arr.len, 0, NULL, &res) == ICE_ARR_TRUE) return res;
+    }
+#endif
+    
+    return ice_arr_max_kernel(arr.arr, arr.len, -HUGE_VAL);
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_compact(ice_arr_array arr) {
+    int zeros = ice_arr_matches(arr, 0);
+    int count = 0;
+    ice_arr_array res = ice_arr_new(arr.len - zeros);
+    
+    for (int i = 0; i < arr.len; i++) {
+        if (arr.arr[i] != 0) {
+            res.arr[count] = arr.arr[i];
+            count++;
+        }
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_tail(ice_arr_array arr) {
+    ice_arr_array res = ice_arr_new((arr.len > 1) ? arr.len - 1 : 0);
+    
+    for (int i = 1; i < arr.len; i++) {
+        res.arr[i - 1] = arr.arr[i];
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_intersect(ice_arr_array a1, ice_arr_array a2) {
+    return ice_arr_intersect_with_mode(a1, a2, ICE_ARR_SET_HASH);
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_foreach(ice_arr_array arr, ice_arr_iter_func f) {
+#if defined(ICE_ARR_PARALLEL)
+    if (arr.len >= ICE_ARR_PARALLEL_MIN) {
+        ice_arr_parallel(ICE_ARR_PARALLEL_OP_FOREACH, arr.arr, arr.len, 0, f, NULL);
+        return;
+    }
+#endif
+    
+    for (int i = 0; i < arr.len; i++) {
+        f(arr.arr[i]);
+    }
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_foreach_ctx(ice_arr_array arr, ice_arr_iter_ctx_func f, void* ctx) {
+#if defined(ICE_ARR_PARALLEL)
+    if (arr.len >= ICE_ARR_PARALLEL_MIN) {
+        ice_arr_parallel_foreach_ctx c = { arr.arr, arr.len, f, NULL, ctx };
+        ice_arr_parallel_run(ice_arr_parallel_foreach_task, &c, ice_arr_parallel_chunks(arr.len));
+        return;
+    }
+#endif
+    
+    for (int i = 0; i < arr.len; i++) {
+        f(ctx, i, arr.arr[i]);
+    }
+}
+
+// Calls f once per block of ICE_ARR_FOREACH_CHUNK elements (Last block can be shorter), index is index of first element of block
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_foreach_chunk(ice_arr_array arr, ice_arr_chunk_func f, void* ctx) {
+#if defined(ICE_ARR_PARALLEL)
+    if (arr.len >= ICE_ARR_PARALLEL_MIN) {
+        ice_arr_parallel_foreach_ctx c = { arr.arr, arr.len, NULL, f, ctx };
+        ice_arr_parallel_run(ice_arr_parallel_foreach_task, &c, ice_arr_parallel_chunks(arr.len));
+        return;
+    }
+#endif
+    
+    for (int i = 0; i < arr.len; i += ICE_ARR_FOREACH_CHUNK) {
+        f(ctx, i, arr.arr + i, (arr.len - i < ICE_ARR_FOREACH_CHUNK) ? (arr.len - i) : ICE_ARR_FOREACH_CHUNK);
+    }
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_union(ice_arr_array a1, ice_arr_array a2) {
+    return ice_arr_union_with_mode(a1, a2, ICE_ARR_SET_HASH);
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rotate(ice_arr_array* arr, int times) {
+    int k;
+    
+    if (arr->len <= 1) return;
+    
+    k = times % arr->len;
+    if (k < 0) k += arr->len;
+    if (k == 0) return;
+    
+    // Rotating left by k is reversing first k elements, Then the rest, Then whole array (O(n) instead of O(n * times))
+    for (int i = 0, j = k - 1; i < j; i++, j--) ice_arr_swap(arr->arr + i, arr->arr + j);
+    for (int i = k, j = arr->len - 1; i < j; i++, j--) ice_arr_swap(arr->arr + i, arr->arr + j);
+    ice_arr_rev(arr);
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_move(ice_arr_array* a1, int from_index, int elems_count, int to_index, ice_arr_array* a2) {
+    // Only elements that exist in a1 are copied
+    if (from_index < 0 || to_index < 0 || from_index >= a1->len) return;
+    if (elems_count > a1->len - from_index) elems_count = a1->len - from_index;
+    if (elems_count <= 0) return;
+    
+    if (ice_arr_grow(a2, to_index + elems_count) == ICE_ARR_FALSE) return;
+    
+    // Gap between end of a2 and to_index is zero-filled like ice_arr_new, memmove as a1 and a2 can be same array
+    if (to_index > a2->len) {
+        memset(a2->arr + a2->len, 0, (to_index - a2->len) * sizeof(double));
+    }
+    
+    memmove(a2->arr + to_index, a1->arr + from_index, elems_count * sizeof(double));
+    
+    if (a2->len < to_index + elems_count) {
+        a2->len = to_index + elems_count;
+    }
+}
+
+// Ranges smaller than this are sorted with Insertion sort
+#define ICE_ARR_SORT_CUTOFF 16
+
+// If f is NULL compares numbers directly, Else f(b, a) returning 1 means a comes before b (Same contract as ice_arr_sort_ex)
+#define ICE_ARR_SORT_LESS(a, b) ((f == NULL) ? ((a) < (b)) : ((int) f((b), (a)) == 1))
+
+// Introsort (Quicksort with median of three and Hoare partition, Heapsort once recursion is too deep and Insertion sort for small ranges)
+// Generates NAME_insertion, NAME_sift, NAME_heap, NAME_intro and NAME_introsort(a, n, f) for elements of type T, Used by doubles and typed arrays
+// LESS(a, b) must be 1 if a comes before b, f (Of type F) is passed through for LESS to use
+// Hoare partition keeps bounds checks so it's safe with NaN or inconsistent comparison functions, Smaller part is recursed into so stack depth stays O(log n)
+#define ICE_ARR_IMPLEMENT_INTROSORT(NAME, T, F, LESS) \
+    static void NAME##_insertion(T* a, int lo, int hi, F f) { \
+        (void) f; \
+        for (int i = lo + 1; i < hi; i++) { \
+            T tmp = a[i]; \
+            int j = i; \
+            while (j > lo && LESS(tmp, a[j - 1])) { a[j] = a[j - 1]; j--; } \
+            a[j] = tmp; \
+        } \
+    } \
+    \
+    static void NAME##_sift(T* a, int root, int n, F f) { \
+        T tmp = a[root]; \
+        (void) f; \
+        while (root * 2 + 1 < n) { \
+            int child = root * 2 + 1; \
+            if (child + 1 < n && LESS(a[child], a[child + 1])) child++; \
+            if (!LESS(tmp, a[child])) break; \
+            a[root] = a[child]; \
+            root = child; \
+        } \
+        a[root] = tmp; \
+    } \
+    \
+    static void NAME##_heap(T* a, int n, F f) { \
+        for (int i = n / 2 - 1; i >= 0; i--) NAME##_sift(a, i, n, f); \
+        for (int i = n - 1; i > 0; i--) { \
+            T tmp = a[0]; a[0] = a[i]; a[i] = tmp; \
+            NAME##_sift(a, 0, i, f); \
+        } \
+    } \
+    \
+    static void NAME##_intro(T* a, int lo, int hi, int depth, F f) { \
+        while (hi - lo > ICE_ARR_SORT_CUTOFF) { \
+            int mid = lo + (hi - lo) / 2; \
+            int i = lo - 1; \
+            int j = hi; \
+            T pivot, tmp; \
+            if (depth-- == 0) { \
+                NAME##_heap(a + lo, hi - lo, f); \
+                return; \
+            } \
+            if (LESS(a[mid], a[lo])) { tmp = a[mid]; a[mid] = a[lo]; a[lo] = tmp; } \
+            if (LESS(a[hi - 1], a[mid])) { tmp = a[hi - 1]; a[hi - 1] = a[mid]; a[mid] = tmp; } \
+            if (LESS(a[mid], a[lo])) { tmp = a[mid]; a[mid] = a[lo]; a[lo] = tmp; } \
+            pivot = a[mid]; \
+            for (;;) { \
+                do i++; while (i < hi - 1 && LESS(a[i], pivot)); \
+                do j--; while (j > lo && LESS(pivot, a[j])); \
+                if (i >= j) break; \
+                tmp = a[i]; a[i] = a[j]; a[j] = tmp; \
+            } \
+            if (j >= hi - 1) j = hi - 2; \
+            if (j + 1 - lo < hi - (j + 1)) { \
+                NAME##_intro(a, lo, j + 1, depth, f); \
+                lo = j + 1; \
+            } else { \
+                NAME##_intro(a, j + 1, hi, depth, f); \
+                hi = j + 1; \
+            } \
+        } \
+        NAME##_insertion(a, lo, hi, f); \
+    } \
+    \
+    static void NAME##_introsort(T* a, int n, F f) { \
+        int depth = 0; \
+        for (int i = n; i > 1; i >>= 1) depth += 2; \
+        NAME##_intro(a, 0, n, depth, f); \
+    }
+
+ICE_ARR_IMPLEMENT_INTROSORT(ice_arr_sort, double, ice_arr_res_func, ICE_ARR_SORT_LESS)
+
+// Maps double bits to unsigned key with same ordering (Flip all bits of negatives, Flip sign bit of positives)
+static uint64_t ice_arr_sort_key(double n) {
+    uint64_t k;
+    memcpy(&k, &n, sizeof(k));
+    return (k & 0x8000000000000000ULL) ? ~k : (k | 0x8000000000000000ULL);
+}
+
+static double ice_arr_sort_unkey(uint64_t k) {
+    double n;
+    k = (k & 0x8000000000000000ULL) ? (k & 0x7FFFFFFFFFFFFFFFULL) : ~k;
+    memcpy(&n, &k, sizeof(n));
+    return n;
+}
+
+static ice_arr_bool ice_arr_sort_radix(double* a, int n) {
+    int counts[8][256];
+    uint64_t* buf = (uint64_t*) ICE_ARR_MALLOC(2 * (size_t) n * sizeof(uint64_t));
+    uint64_t* src = buf;
+    uint64_t* dst = buf + n;
+    
+    if (buf == NULL) {
+        return ICE_ARR_FALSE;
+    }
+    
+    memset(counts, 0, sizeof(counts));
+    
+    for (int i = 0; i < n; i++) {
+        uint64_t k = ice_arr_sort_key(a[i]);
+        src[i] = k;
+        
+        for (int d = 0; d < 8; d++) {
+            counts[d][(k >> (d * 8)) & 0xFF]++;
+        }
+    }
+    
+    for (int d = 0; d < 8; d++) {
+        int* c = counts[d];
+        int sum = 0;
+        uint64_t* tmp;
+        
+        // Skip pass if all keys have same byte at this digit
+        if (c[(src[0] >> (d * 8)) & 0xFF] == n) continue;
+        
+        for (int i = 0; i < 256; i++) {
+            int count = c[i];
+            c[i] = sum;
+            sum += count;
+        }
+        
+        for (int i = 0; i < n; i++) {
+            dst[c[(src[i] >> (d * 8)) & 0xFF]++] = src[i];
+        }
+        
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        a[i] = ice_arr_sort_unkey(src[i]);
+    }
+    
+    ICE_ARR_FREE(buf);
+    return ICE_ARR_TRUE;
+}
+
+// Sorts from bigger to smaller, Kept for compatibility (Sorted arrays functions need ice_arr_sort_asc)
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort(ice_arr_array* arr) {
+    ice_arr_sort_asc(arr);
+    ice_arr_rev(arr);
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort_asc(ice_arr_array* arr) {
+#if defined(ICE_ARR_PARALLEL)
+    if (arr->len >= ICE_ARR_PARALLEL_MIN) {
+        if (ice_arr_parallel_sort(arr->arr, arr->len) == ICE_ARR_TRUE) return;
+    }
+#endif
+    
+    ice_arr_sort_introsort(arr->arr, arr->len, NULL);
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort_ex(ice_arr_array* arr, ice_arr_res_func f) {
+    ice_arr_sort_introsort(arr->arr, arr->len, f);
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort_with_mode(ice_arr_array* arr, ice_arr_sort_mode mode) {
+    if (mode == ICE_ARR_SORT_RADIX && arr->len > ICE_ARR_SORT_CUTOFF) {
+        if (ice_arr_sort_radix(arr->arr, arr->len) == ICE_ARR_TRUE) return;
+    }
+    
+    ice_arr_sort_introsort(arr->arr, arr->len, NULL);
+}
+
+// Open addressing hash set keyed on bits of doubles, Used by set operations
+typedef struct ice_arr_hashset_entry {
+    uint64_t key;
+    int count;      // 0 means slot is empty
+} ice_arr_hashset_entry;
+
+typedef struct ice_arr_hashset {
+    ice_arr_hashset_entry* entries;
+    uint64_t mask;
+    int shift;
+} ice_arr_hashset;
+
+// Canonical bits of double, All NaNs map to one key and -0.0 maps to 0.0
+static uint64_t ice_arr_hashset_key(double n) {
+    uint64_t k;
+    
+    if (n != n) return 0x7FF8000000000000ULL;
+    if (n == 0) return 0;
+    
+    memcpy(&k, &n, sizeof(k));
+    return k;
+}
+
+static ice_arr_bool ice_arr_hashset_init(ice_arr_hashset* set, int n) {
+    int bits = 4;
+    
+    while (((int64_t) 1 << bits) < (int64_t) n * 2) bits++;
+    
+    set->entries = (ice_arr_hashset_entry*) ICE_ARR_CALLOC((size_t) 1 << bits, sizeof(ice_arr_hashset_entry));
+    set->mask = ((uint64_t) 1 << bits) - 1;
+    set->shift = 64 - bits;
+    
+    return (set->entries == NULL) ? ICE_ARR_FALSE : ICE_ARR_TRUE;
+}
+
+// Returns entry of key in set, If not found then inserts it with count 0 (If insert is ICE_ARR_TRUE) or returns NULL
+static ice_arr_hashset_entry* ice_arr_hashset_find_key(ice_arr_hashset* set, uint64_t key, ice_arr_bool insert) {
+    uint64_t i = (key * 0x9E3779B97F4A7C15ULL) >> set->shift;
+    
+    for (;;) {
+        ice_arr_hashset_entry* e = set->entries + i;
+        
+        if (e->count == 0) {
+            if (insert == ICE_ARR_FALSE) return NULL;
+            e->key = key;
+            return e;
+        }
+        
+        if (e->key == key) return e;
+        
+        i = (i + 1) & set->mask;
+    }
+}
+
+static ice_arr_hashset_entry* ice_arr_hashset_find(ice_arr_hashset* set, double n, ice_arr_bool insert) {
+    return ice_arr_hashset_find_key(set, ice_arr_hashset_key(n), insert);
+}
+
+// Sort key of canonical bits (All NaNs become one NaN and -0.0 becomes 0.0), Sort-merge mode sorts and merges by it
+static uint64_t ice_arr_set_order(double n) {
+    uint64_t k = ice_arr_hashset_key(n);
+    double c;
+    memcpy(&c, &k, sizeof(c));
+    return ice_arr_sort_key(c);
+}
+
+// Comparison function for sort-merge mode, Total order over canonical bits so NaN and -0.0 sort consistently
+static int ice_arr_set_cmp(double a, double b) {
+    return (ice_arr_set_order(a) > ice_arr_set_order(b)) ? 1 : 0;
+}
+
+// Creates empty array with space allocated for capacity elements, Returns ICE_ARR_FALSE if allocation failed
+static ice_arr_bool ice_arr_alloc(ice_arr_array* res, int capacity) {
+    *res = ice_arr_new(0);
+    return ice_arr_reserve(res, capacity);
+}
+
+// Sorted arrays, Inputs must be sorted from smaller to bigger (As done by ice_arr_sort_asc)
+#if defined(__GNUC__) || defined(__clang__)
+#  define ICE_ARR_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#  define ICE_ARR_PREFETCH(ptr)
+#endif
+
+// Branchless binary search, Halves range each step with conditional move instead of branch that CPU can't predict
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_lower_bound(ice_arr_array arr, double val) {
+    const double* base = arr.arr;
+    int n = arr.len;
+    
+    if (n <= 0) {
+        return 0;
+    }
+    
+    while (n > 1) {
+        int half = n / 2;
+        base = (base[half - 1] < val) ? base + half : base;
+        n -= half;
+    }
+    
+    return (int) (base - arr.arr) + (*base < val);
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_upper_bound(ice_arr_array arr, double val) {
+    const double* base = arr.arr;
+    int n = arr.len;
+    
+    if (n <= 0) {
+        return 0;
+    }
+    
+    while (n > 1) {
+        int half = n / 2;
+        base = (base[half - 1] <= val) ? base + half : base;
+        n -= half;
+    }
+    
+    return (int) (base - arr.arr) + (*base <= val);
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_sorted_includes(ice_arr_array arr, double val) {
+    int i = ice_arr_lower_bound(arr, val);
+    return (i < arr.len && arr.arr[i] == val) ? ICE_ARR_TRUE : ICE_ARR_FALSE;
+}
+
+// Fills Eytzinger layout by in-order traversal of implicit tree (Node k has children 2k and 2k + 1, 1-based)
+static int ice_arr_eytzinger_fill(double* res, const double* sorted, int n, int i, int k) {
+    if (k <= n) {
+        i = ice_arr_eytzinger_fill(res, sorted, n, i, 2 * k);
+        res[k - 1] = sorted[i++];
+        i = ice_arr_eytzinger_fill(res, sorted, n, i, 2 * k + 1);
+    }
+    
+    return i;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_eytzinger(ice_arr_array sorted) {
+    ice_arr_array res = ice_arr_new(sorted.len);
+    
+    if (res.len == sorted.len) {
+        ice_arr_eytzinger_fill(res.arr, sorted.arr, sorted.len, 0, 1);
+    }
+    
+    return res;
+}
+
+// Walks tree from root with no branches and prefetches 4 levels ahead, Then undoes right turns taken after last left turn to find answer
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_eytzinger_lower_bound(ice_arr_array eyt, double val) {
+    unsigned int k = 1;
+    unsigned int n = (unsigned int) ((eyt.len > 0) ? eyt.len : 0);
+    
+    while (k <= n) {
+        if (16 * k <= n) ICE_ARR_PREFETCH(eyt.arr + 16 * k - 1);
+        k = 2 * k + (eyt.arr[k - 1] < val);
+    }
+    
+    while (k & 1) k >>= 1;
+    k >>= 1;
+    
+    return (k == 0) ? (int) n : (int) k - 1;
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_eytzinger_includes(ice_arr_array eyt, double val) {
+    int i = ice_arr_eytzinger_lower_bound(eyt, val);
+    return (i < eyt.len && eyt.arr[i] == val) ? ICE_ARR_TRUE : ICE_ARR_FALSE;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_sorted_intersect(ice_arr_array a1, ice_arr_array a2) {
+    ice_arr_array res;
+    int i = 0;
+    int j = 0;
+    
+    if (ice_arr_alloc(&res, (a1.len < a2.len) ? a1.len : a2.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    while (i < a1.len && j < a2.len) {
+        uint64_t k1 = ice_arr_set_order(a1.arr[i]);
+        uint64_t k2 = ice_arr_set_order(a2.arr[j]);
+        
+        if (k1 < k2) {
+            i++;
+        } else if (k2 < k1) {
+            j++;
+        } else {
+            res.arr[res.len++] = a1.arr[i];
+            while (i < a1.len && ice_arr_set_order(a1.arr[i]) == k1) i++;
+            while (j < a2.len && ice_arr_set_order(a2.arr[j]) == k1) j++;
+        }
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_sorted_union(ice_arr_array a1, ice_arr_array a2) {
+    ice_arr_array res;
+    int i = 0;
+    int j = 0;
+    
+    if (ice_arr_alloc(&res, a1.len + a2.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    while (i < a1.len || j < a2.len) {
+        uint64_t k;
+        
+        if (j == a2.len || (i < a1.len && ice_arr_set_order(a1.arr[i]) <= ice_arr_set_order(a2.arr[j]))) {
+            k = ice_arr_set_order(a1.arr[i]);
+            res.arr[res.len++] = a1.arr[i];
+        } else {
+            k = ice_arr_set_order(a2.arr[j]);
+            res.arr[res.len++] = a2.arr[j];
+        }
+        
+        while (i < a1.len && ice_arr_set_order(a1.arr[i]) == k) i++;
+        while (j < a2.len && ice_arr_set_order(a2.arr[j]) == k) j++;
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_unique_with_mode(ice_arr_array arr, ice_arr_set_mode mode) {
+    ice_arr_array res;
+    
+    if (ice_arr_alloc(&res, arr.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    if (mode == ICE_ARR_SET_SORTED) {
+        int i = 0;
+        
+        ice_arr_sort_introsort(arr.arr, arr.len, ice_arr_set_cmp);
+        
+        while (i < arr.len) {
+            uint64_t k = ice_arr_set_order(arr.arr[i]);
+            int j = i + 1;
+            
+            while (j < arr.len && ice_arr_set_order(arr.arr[j]) == k) j++;
+            if (j - i == 1) res.arr[res.len++] = arr.arr[i];
+            
+            i = j;
+        }
+    } else {
+        ice_arr_hashset set;
+        
+        if (ice_arr_hashset_init(&set, arr.len) == ICE_ARR_FALSE) {
+            return res;
+        }
+        
+        for (int i = 0; i < arr.len; i++) {
+            ice_arr_hashset_find(&set, arr.arr[i], ICE_ARR_TRUE)->count++;
+        }
+        
+        for (int i = 0; i < arr.len; i++) {
+            if (ice_arr_hashset_find(&set, arr.arr[i], ICE_ARR_FALSE)->count == 1) {
+                res.arr[res.len++] = arr.arr[i];
+            }
+        }
+        
+        ICE_ARR_FREE(set.entries);
+    }
+    
+    return res;
+}
+
+// Keeps elements of a1 that exist exactly once in a2, Counts of a2 are taken once into hash set so it's O(n + m)
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_diff(ice_arr_array a1, ice_arr_array a2) {
+    ice_arr_array res;
+    ice_arr_hashset set;
+    
+    if (ice_arr_alloc(&res, a1.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    if (ice_arr_hashset_init(&set, a2.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    for (int i = 0; i < a2.len; i++) {
+        ice_arr_hashset_find(&set, a2.arr[i], ICE_ARR_TRUE)->count++;
+    }
+    
+    for (int i = 0; i < a1.len; i++) {
+        ice_arr_hashset_entry* e = ice_arr_hashset_find(&set, a1.arr[i], ICE_ARR_FALSE);
+        
+        if (e != NULL && e->count == 1) {
+            res.arr[res.len++] = a1.arr[i];
+        }
+    }
+    
+    ICE_ARR_FREE(set.entries);
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_except(ice_arr_array a1, ice_arr_array a2) {
+    return ice_arr_except_with_mode(a1, a2, ICE_ARR_SET_HASH);
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_except_with_mode(ice_arr_array a1, ice_arr_array a2, ice_arr_set_mode mode) {
+    ice_arr_array res;
+    
+    if (ice_arr_alloc(&res, a1.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    if (mode == ICE_ARR_SET_SORTED) {
+        int j = 0;
+        
+        ice_arr_sort_introsort(a1.arr, a1.len, ice_arr_set_cmp);
+        ice_arr_sort_introsort(a2.arr, a2.len, ice_arr_set_cmp);
+        
+        for (int i = 0; i < a1.len; i++) {
+            uint64_t k = ice_arr_set_order(a1.arr[i]);
+            
+            while (j < a2.len && ice_arr_set_order(a2.arr[j]) < k) j++;
+            if (j == a2.len || ice_arr_set_order(a2.arr[j]) != k) res.arr[res.len++] = a1.arr[i];
+        }
+    } else {
+        ice_arr_hashset set;
+        
+        if (ice_arr_hashset_init(&set, a2.len) == ICE_ARR_FALSE) {
+            return res;
+        }
+        
+        for (int i = 0; i < a2.len; i++) {
+            ice_arr_hashset_find(&set, a2.arr[i], ICE_ARR_TRUE)->count = 1;
+        }
+        
+        for (int i = 0; i < a1.len; i++) {
+            if (ice_arr_hashset_find(&set, a1.arr[i], ICE_ARR_FALSE) == NULL) {
+                res.arr[res.len++] = a1.arr[i];
+            }
+        }
+        
+        ICE_ARR_FREE(set.entries);
+    }
+    
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_intersect_with_mode(ice_arr_array a1, ice_arr_array a2, ice_arr_set_mode mode) {
+    ice_arr_array res;
+    
+    if (mode == ICE_ARR_SET_SORTED) {
+        ice_arr_sort_introsort(a1.arr, a1.len, ice_arr_set_cmp);
+        ice_arr_sort_introsort(a2.arr, a2.len, ice_arr_set_cmp);
+        return ice_arr_sorted_intersect(a1, a2);
+    }
+    
+    if (ice_arr_alloc(&res, (a1.len < a2.len) ? a1.len : a2.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    ice_arr_hashset set;
+    
+    if (ice_arr_hashset_init(&set, a2.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    for (int i = 0; i < a2.len; i++) {
+        ice_arr_hashset_find(&set, a2.arr[i], ICE_ARR_TRUE)->count = 1;
+    }
+    
+    // Count becomes -1 once element is added to result so it's added once
+    for (int i = 0; i < a1.len; i++) {
+        ice_arr_hashset_entry* e = ice_arr_hashset_find(&set, a1.arr[i], ICE_ARR_FALSE);
+        
+        if (e != NULL && e->count == 1) {
+            res.arr[res.len++] = a1.arr[i];
+            e->count = -1;
+        }
+    }
+    
+    ICE_ARR_FREE(set.entries);
+    return res;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_union_with_mode(ice_arr_array a1, ice_arr_array a2, ice_arr_set_mode mode) {
+    ice_arr_array res;
+    
+    if (mode == ICE_ARR_SET_SORTED) {
+        ice_arr_sort_introsort(a1.arr, a1.len, ice_arr_set_cmp);
+        ice_arr_sort_introsort(a2.arr, a2.len, ice_arr_set_cmp);
+        return ice_arr_sorted_union(a1, a2);
+    }
+    
+    if (ice_arr_alloc(&res, a1.len + a2.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    ice_arr_hashset set;
+    
+    if (ice_arr_hashset_init(&set, a1.len + a2.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    for (int i = 0; i < a1.len; i++) {
+        ice_arr_hashset_entry* e = ice_arr_hashset_find(&set, a1.arr[i], ICE_ARR_TRUE);
+        if (e->count++ == 0) res.arr[res.len++] = a1.arr[i];
+    }
+    
+    for (int i = 0; i < a2.len; i++) {
+        ice_arr_hashset_entry* e = ice_arr_hashset_find(&set, a2.arr[i], ICE_ARR_TRUE);
+        if (e->count++ == 0) res.arr[res.len++] = a2.arr[i];
+    }
+    
+    ICE_ARR_FREE(set.entries);
+    return res;
+}
+
+// Element-wise arithmetic, Operations on 2 arrays use length of shorter one
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_add(ice_arr_array a1, ice_arr_array a2) {
+    ice_arr_array res = ice_arr_new((a1.len < a2.len) ? a1.len : a2.len);
+    ice_arr_add_kernel(res.arr, a1.arr, a2.arr, res.len);
+    return res;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_add_inplace(ice_arr_array* a1, ice_arr_array a2) {
+    ice_arr_add_kernel(a1->arr, a1->arr, a2.arr, (a1->len < a2.len) ? a1->len : a2.len);
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_mul(ice_arr_array a1, ice_arr_array a2) {
+    ice_arr_array res = ice_arr_new((a1.len < a2.len) ? a1.len : a2.len);
+    ice_arr_mul_kernel(res.arr, a1.arr, a2.arr, res.len);
+    return res;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_mul_inplace(ice_arr_array* a1, ice_arr_array a2) {
+    ice_arr_mul_kernel(a1->arr, a1->arr, a2.arr, (a1->len < a2.len) ? a1->len : a2.len);
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_scale(ice_arr_array arr, double alpha) {
+    ice_arr_array res = ice_arr_new(arr.len);
+    ice_arr_scale_kernel(res.arr, arr.arr, alpha, res.len);
+    return res;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_scale_inplace(ice_arr_array* arr, double alpha) {
+    ice_arr_scale_kernel(arr->arr, arr->arr, alpha, arr->len);
+}
+
+// Returns alpha * x + y
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_axpy(double alpha, ice_arr_array x, ice_arr_array y) {
+    ice_arr_array res = ice_arr_new((x.len < y.len) ? x.len : y.len);
+    
+    if (res.len > 0) {
+        memcpy(res.arr, y.arr, res.len * sizeof(double));
+        ice_arr_axpy_kernel(res.arr, alpha, x.arr, res.len);
+    }
+    
+    return res;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_axpy_inplace(double alpha, ice_arr_array x, ice_arr_array* y) {
+    ice_arr_axpy_kernel(y->arr, alpha, x.arr, (x.len < y->len) ? x.len : y->len);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_dot(ice_arr_array a1, ice_arr_array a2) {
+    return ice_arr_dot_kernel(a1.arr, a2.arr, (a1.len < a2.len) ? a1.len : a2.len);
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_map(ice_arr_array arr, ice_arr_map_func f) {
+    ice_arr_array res = ice_arr_new(arr.len);
+    
+    for (int i = 0; i < res.len; i++) {
+        res.arr[i] = f(arr.arr[i]);
+    }
+    
+    return res;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_map_inplace(ice_arr_array* arr, ice_arr_map_func f) {
+    for (int i = 0; i < arr->len; i++) {
+        arr->arr[i] = f(arr->arr[i]);
+    }
+}
+
+// In-place filters, Each one moves kept elements to front of array with write cursor in single pass and returns count of removed elements
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_remove_all(ice_arr_array* arr, double val) {
+    int count = 0;
+    
+    for (int i = 0; i < arr->len; i++) {
+        double n = arr->arr[i];
+        arr->arr[count] = n;
+        count += (n != val);
+    }
+    
+    int removed = arr->len - count;
+    arr->len = count;
+    return removed;
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_compact_inplace(ice_arr_array* arr) {
+    return ice_arr_remove_all(arr, 0);
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_filter_inplace(ice_arr_array* arr, ice_arr_pred_func f) {
+    int count = 0;
+    
+    for (int i = 0; i < arr->len; i++) {
+        if (f(arr->arr[i]) == 1) {
+            arr->arr[count] = arr->arr[i];
+            count++;
+        }
+    }
+    
+    int removed = arr->len - count;
+    arr->len = count;
+    return removed;
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_dedup_inplace(ice_arr_array* arr) {
+    return ice_arr_dedup_inplace_with_mode(arr, ICE_ARR_SET_HASH);
+}
+
+// Unlike ice_arr_unique, First occurrence of repeated elements is kept, Returns -1 if set allocation failed (Array is left unchanged)
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_dedup_inplace_with_mode(ice_arr_array* arr, ice_arr_set_mode mode) {
+    int count = 0;
+    
+    if (arr->len < 2) {
+        return 0;
+    }
+    
+    if (mode == ICE_ARR_SET_SORTED) {
+        uint64_t prev;
+        
+        ice_arr_sort_introsort(arr->arr, arr->len, ice_arr_set_cmp);
+        prev = ice_arr_set_order(arr->arr[0]);
+        count = 1;
+        
+        for (int i = 1; i < arr->len; i++) {
+            uint64_t k = ice_arr_set_order(arr->arr[i]);
+            
+            if (k != prev) {
+                arr->arr[count] = arr->arr[i];
+                count++;
+                prev = k;
+            }
+        }
+    } else {
+        ice_arr_hashset set;
+        
+        if (ice_arr_hashset_init(&set, arr->len) == ICE_ARR_FALSE) {
+            return -1;
+        }
+        
+        for (int i = 0; i < arr->len; i++) {
+            if (ice_arr_hashset_find(&set, arr->arr[i], ICE_ARR_TRUE)->count++ == 0) {
+                arr->arr[count] = arr->arr[i];
+                count++;
+            }
+        }
+        
+        ICE_ARR_FREE(set.entries);
+    }
+    
+    int removed = arr->len - count;
+    arr->len = count;
+    return removed;
+}
+
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_view_of(ice_arr_array arr) {
+    return (ice_arr_view) { arr.arr, arr.len, 1 };
+}
+
+// Same as ice_arr_first, At least 1 element is viewed (Unless array is empty)
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_first_view(ice_arr_array arr, int elems) {
+    return ice_arr_view_sub(ice_arr_view_of(arr), 0, ((elems <= 1) ? 1 : elems) - 1);
+}
+
+// Same as ice_arr_last, Elements are viewed from last element backwards
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_last_view(ice_arr_array arr, int elems) {
+    if (arr.len == 0) {
+        return (ice_arr_view) { arr.arr, 0, -1 };
+    }
+    
+    ice_arr_view res = { arr.arr + arr.len - 1, arr.len, -1 };
+    return ice_arr_view_sub(res, 0, ((elems <= 1) ? 1 : elems) - 1);
+}
+
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_sub_view(ice_arr_array arr, int from, int to) {
+    return ice_arr_view_sub(ice_arr_view_of(arr), from, to);
+}
+
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_tail_view(ice_arr_array arr) {
+    return ice_arr_view_sub(ice_arr_view_of(arr), 1, arr.len - 1);
+}
+
+// Returns view of elements from index from to index to (Both included) of view, Indexes are clamped to view bounds
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_view_sub(ice_arr_view view, int from, int to) {
+    if (from < 0) from = 0;
+    if (to > view.len - 1) to = view.len - 1;
+    
+    if (from > to) {
+        return (ice_arr_view) { view.arr, 0, view.stride };
+    }
+    
+    return (ice_arr_view) { view.arr + (ptrdiff_t) from * view.stride, (to - from) + 1, view.stride };
+}
+
+// Returns view of every step-th element of view (Subsampling)
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_view_step(ice_arr_view view, int step) {
+    if (step <= 1) {
+        return view;
+    }
+    
+    return (ice_arr_view) { view.arr, (view.len + step - 1) / step, view.stride * step };
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_view_get(ice_arr_view view, int index) {
+    if (index >= 0 && index < view.len) {
+        return view.arr[(ptrdiff_t) index * view.stride];
+    }
+    
+    return 0;
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_view_len(ice_arr_view view) {
+    return view.len;
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_view_sum(ice_arr_view view) {
+    double res = 0;
+    
+    if (view.stride == 1) {
+        return ice_arr_sum_kernel(view.arr, view.len);
+    }
+    
+    for (int i = 0; i < view.len; i++) {
+        res += view.arr[(ptrdiff_t) i * view.stride];
+    }
+    
+    return res;
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_view_min(ice_arr_view view) {
+    double res = HUGE_VAL;
+    
+    if (view.stride == 1) {
+        return ice_arr_min_kernel(view.arr, view.len, res);
+    }
+    
+    for (int i = 0; i < view.len; i++) {
+        double n = view.arr[(ptrdiff_t) i * view.stride];
+        if (n < res) res = n;
+    }
+    
+    return res;
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_view_max(ice_arr_view view) {
+    double res = -HUGE_VAL;
+    
+    if (view.stride == 1) {
+        return ice_arr_max_kernel(view.arr, view.len, res);
+    }
+    
+    for (int i = 0; i < view.len; i++) {
+        double n = view.arr[(ptrdiff_t) i * view.stride];
+        if (n > res) res = n;
+    }
+    
+    return res;
+}
+
+// Copies elements of view into new array (Allocated, Free it with ice_arr_free)
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_view_to_array(ice_arr_view view) {
+    ice_arr_array res;
+    
+    if (ice_arr_alloc(&res, view.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    if (view.stride == 1) {
+        memcpy(res.arr, view.arr, view.len * sizeof(double));
+    } else {
+        for (int i = 0; i < view.len; i++) {
+            res.arr[i] = view.arr[(ptrdiff_t) i * view.stride];
+        }
+    }
+    
+    res.len = view.len;
+    return res;
+}
+
+// Returns index in ring content of element at index of ring
+static int ice_arr_ring_index(ice_arr_ring* ring, int index) {
+    int i = ring->head + index;
+    return (i >= ring->capacity) ? (i - ring->capacity) : i;
+}
+
+// Grows ring capacity by x1.5 and moves elements to start of new allocation
+static ice_arr_bool ice_arr_ring_grow(ice_arr_ring* ring) {
+    int capacity = ring->capacity + (ring->capacity / 2);
+    int first;
+    double* res;
+    
+    if (capacity < ICE_ARR_MIN_CAPACITY) capacity = ICE_ARR_MIN_CAPACITY;
+    
+    res = (double*) ICE_ARR_MALLOC(capacity * sizeof(double));
+    
+    if (res == NULL) {
+        return ICE_ARR_FALSE;
+    }
+    
+    first = (ring->capacity - ring->head < ring->len) ? (ring->capacity - ring->head) : ring->len;
+    memcpy(res, ring->arr + ring->head, first * sizeof(double));
+    memcpy(res + first, ring->arr, (ring->len - first) * sizeof(double));
+    
+    ICE_ARR_FREE(ring->arr);
+    ring->arr = res;
+    ring->head = 0;
+    ring->capacity = capacity;
+    
+    return ICE_ARR_TRUE;
+}
+
+ICE_ARR_API ice_arr_ring ICE_ARR_CALLCONV ice_arr_ring_new(int capacity) {
+    ice_arr_ring res = { NULL, 0, 0, (capacity > 0) ? capacity : ICE_ARR_MIN_CAPACITY };
+    
+    res.arr = (double*) ICE_ARR_MALLOC(res.capacity * sizeof(double));
+    if (res.arr == NULL) res.capacity = 0;
+    
+    return res;
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_ring_get(ice_arr_ring ring, int index) {
+    if (index >= 0 && index < ring.len) {
+        return ring.arr[ice_arr_ring_index(&ring, index)];
+    }
+    
+    return 0;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_ring_set(ice_arr_ring* ring, int index, double val) {
+    if (index >= 0 && index < ring->len) {
+        ring->arr[ice_arr_ring_index(ring, index)] = val;
+    }
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_ring_len(ice_arr_ring ring) {
+    return ring.len;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_ring_push_back(ice_arr_ring* ring, double val) {
+    if (ring->len == ring->capacity) {
+        if (ice_arr_ring_grow(ring) == ICE_ARR_FALSE) return;
+    }
+    
+    ring->arr[ice_arr_ring_index(ring, ring->len)] = val;
+    ring->len++;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_ring_push_front(ice_arr_ring* ring, double val) {
+    if (ring->len == ring->capacity) {
+        if (ice_arr_ring_grow(ring) == ICE_ARR_FALSE) return;
+    }
+    
+    ring->head = (ring->head == 0) ? (ring->capacity - 1) : (ring->head - 1);
+    ring->arr[ring->head] = val;
+    ring->len++;
+}
+
+// Pushes element to end of ring, If ring is full then first element gets dropped instead of growing (Sliding window)
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_ring_push_overwrite(ice_arr_ring* ring, double val) {
+    if (ring->capacity == 0) return;
+    
+    if (ring->len == ring->capacity) {
+        ring->arr[ring->head] = val;
+        ring->head = ice_arr_ring_index(ring, 1);
+    } else {
+        ring->arr[ice_arr_ring_index(ring, ring->len)] = val;
+        ring->len++;
+    }
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_ring_pop_back(ice_arr_ring* ring) {
+    if (ring->len == 0) return 0;
+    
+    ring->len--;
+    return ring->arr[ice_arr_ring_index(ring, ring->len)];
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_ring_pop_front(ice_arr_ring* ring) {
+    double res;
+    
+    if (ring->len == 0) return 0;
+    
+    res = ring->arr[ring->head];
+    ring->head = ice_arr_ring_index(ring, 1);
+    ring->len--;
+    
+    return res;
+}
+
+// Rotates ring to left by times, O(1) if ring is full, Else moves min(times, len - times) elements between ends
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_ring_rotate(ice_arr_ring* ring, int times) {
+    int k;
+    
+    if (ring->len <= 1) return;
+    
+    k = times % ring->len;
+    if (k < 0) k += ring->len;
+    if (k == 0) return;
+    
+    if (ring->len == ring->capacity) {
+        ring->head = ice_arr_ring_index(ring, k);
+    } else if (k <= ring->len / 2) {
+        while (k-- > 0) ice_arr_ring_push_back(ring, ice_arr_ring_pop_front(ring));
+    } else {
+        k = ring->len - k;
+        while (k-- > 0) ice_arr_ring_push_front(ring, ice_arr_ring_pop_back(ring));
+    }
+}
+
+// Copies ring elements in order into new contiguous array (Allocated, Free it with ice_arr_free)
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_ring_to_array(ice_arr_ring ring) {
+    ice_arr_array res;
+    int first = (ring.capacity - ring.head < ring.len) ? (ring.capacity - ring.head) : ring.len;
+    
+    if (ice_arr_alloc(&res, ring.len) == ICE_ARR_FALSE) {
+        return res;
+    }
+    
+    memcpy(res.arr, ring.arr + ring.head, first * sizeof(double));
+    memcpy(res.arr + first, ring.arr, (ring.len - first) * sizeof(double));
+    res.len = ring.len;
+    
     return res;
 }
 
-ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_min(ice_arr_array arr) {
-    double n  = (1 / 0);
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_ring_free(ice_arr_ring ring) {
+    ICE_ARR_FREE(ring.arr);
+}
+
+ICE_ARR_API ice_arr_small ICE_ARR_CALLCONV ice_arr_small_new(void) {
+    ice_arr_small res;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] < n) {
-            n = arr.arr[i];
-        }
+    res.heap = NULL;
+    res.len = 0;
+    res.real_len = ICE_ARR_SMALL_CAPACITY;
+    
+    return res;
+}
+
+ICE_ARR_API double* ICE_ARR_CALLCONV ice_arr_small_data(ice_arr_small* arr) {
+    return (arr->heap != NULL) ? arr->heap : arr->inline_arr;
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_small_get(ice_arr_small* arr, int index) {
+    if (index >= 0 && index < arr->len) {
+        return ice_arr_small_data(arr)[index];
     }
     
-    return n;
+    return 0;
 }
 
-ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_max(ice_arr_array arr) {
-    double n  = -(1 / 0);
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_small_set(ice_arr_small* arr, int index, double val) {
+    if (index >= 0 && index < arr->len) {
+        ice_arr_small_data(arr)[index] = val;
+    }
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_small_len(ice_arr_small* arr) {
+    return arr->len;
+}
+
+// Moves elements to allocation once inline storage is full, Later growth is same as ice_arr_array
+static ice_arr_bool ice_arr_small_grow(ice_arr_small* arr, int capacity) {
+    ice_arr_array tmp = { arr->heap, arr->len, (arr->heap != NULL) ? arr->real_len : 0 };
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] > n) {
-            n = arr.arr[i];
-        }
+    if (capacity <= arr->real_len) {
+        return ICE_ARR_TRUE;
     }
     
-    return n;
+    if (arr->heap == NULL && capacity < ICE_ARR_SMALL_CAPACITY * 2) {
+        capacity = ICE_ARR_SMALL_CAPACITY * 2;
+    }
+    
+    if (ice_arr_grow(&tmp, capacity) == ICE_ARR_FALSE) {
+        return ICE_ARR_FALSE;
+    }
+    
+    if (arr->heap == NULL) {
+        memcpy(tmp.arr, arr->inline_arr, arr->len * sizeof(double));
+    }
+    
+    arr->heap = tmp.arr;
+    arr->real_len = tmp.real_len;
+    
+    return ICE_ARR_TRUE;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_compact(ice_arr_array arr) {
-    int zeros = ice_arr_matches(arr, 0);
-    int count = 0;
-    ice_arr_array res = ice_arr_new(arr.len - zeros);
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_small_push(ice_arr_small* arr, double val) {
+    if (arr->len == arr->real_len && ice_arr_small_grow(arr, arr->len + 1) == ICE_ARR_FALSE) {
+        return;
+    }
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] != 0) {
-            res.arr[count] = arr.arr[i];
-            count++;
-        }
+    ice_arr_small_data(arr)[arr->len++] = val;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_small_pop(ice_arr_small* arr) {
+    if (arr->len > 0) {
+        arr->len--;
+    }
+}
+
+// View is valid until array grows, Gets freed or (While elements are inline) moves
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_small_view(ice_arr_small* arr) {
+    return (ice_arr_view) { ice_arr_small_data(arr), arr->len, 1 };
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_small_to_array(ice_arr_small* arr) {
+    ice_arr_array res = ice_arr_new(arr->len);
+    
+    if (res.len > 0) {
+        memcpy(res.arr, ice_arr_small_data(arr), res.len * sizeof(double));
     }
     
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_tail(ice_arr_array arr) {
-    ice_arr_array res = ice_arr_new(arr.len - 1);
-    
-    for (int i = 1; i < arr.len; i++) {
-        res.arr[i - 1] = arr.arr[i];
+// Frees allocation (If any) and leaves array empty so it can be reused
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_small_free(ice_arr_small* arr) {
+    if (arr->heap != NULL) {
+        ice_arr_mem_free(arr->heap);
     }
     
+    *arr = ice_arr_small_new();
+}
+
+ICE_ARR_API ice_arr_stats ICE_ARR_CALLCONV ice_arr_stats_new(void) {
+    return (ice_arr_stats) { 0, 0, 0, HUGE_VAL, -HUGE_VAL };
+}
+
+ICE_ARR_API ice_arr_stats ICE_ARR_CALLCONV ice_arr_stats_of(ice_arr_array arr) {
+    ice_arr_stats res = ice_arr_stats_new();
+    ice_arr_stats_push_n(&res, arr.arr, arr.len);
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_intersect(ice_arr_array a1, ice_arr_array a2) {
-    int len = 0;
-    int count = 0;
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_stats_push(ice_arr_stats* stats, double val) {
+    if (val != val) {
+        return;
+    }
     
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) >= 1 && ice_arr_matches(a1, a1.arr[i]) >= 1) {
-            len++;
+    double delta = val - stats->mean;
+    
+    stats->count++;
+    stats->mean += delta / (double) stats->count;
+    stats->m2 += delta * (val - stats->mean);
+    
+    if (val < stats->min) stats->min = val;
+    if (val > stats->max) stats->max = val;
+}
+
+// Batch gets its own mean and m2 in 2 passes (Loops without division that compilers vectorize), Then it's merged like another accumulator
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_stats_push_n(ice_arr_stats* stats, double* vals, int count) {
+    ice_arr_stats batch = ice_arr_stats_new();
+    double sum = 0;
+    double m2 = 0;
+    int64_t n = 0;
+    
+    for (int i = 0; i < count; i++) {
+        if (vals[i] == vals[i]) {
+            sum += vals[i];
+            n++;
         }
     }
     
-    ice_arr_array res = ice_arr_new(len);
+    if (n == 0) {
+        return;
+    }
     
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) >= 1) {
-            if (ice_arr_matches(a1, a1.arr[i])) {
-                res.arr[count] = a2.arr[i];
-                count++;
-            }
-        } else if (ice_arr_matches(a1, a1.arr[i]) >= 1) {
-            if (ice_arr_matches(a2, a1.arr[i])) {
-                res.arr[count] = a1.arr[i];
-                count++;
-            }
+    batch.count = n;
+    batch.mean = sum / (double) n;
+    
+    for (int i = 0; i < count; i++) {
+        if (vals[i] == vals[i]) {
+            double d = vals[i] - batch.mean;
+            m2 += d * d;
         }
     }
     
-    return res;
+    batch.m2 = m2;
+    batch.min = ice_arr_min_kernel(vals, count, HUGE_VAL);
+    batch.max = ice_arr_max_kernel(vals, count, -HUGE_VAL);
+    
+    ice_arr_stats_merge(stats, batch);
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_foreach(ice_arr_array arr, ice_arr_iter_func f) {
-    for (int i = 0; i < arr.len; i++) {
-        f(arr.arr[i]);
+// Chan et al. parallel formula for combining means and m2 of 2 accumulators
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_stats_merge(ice_arr_stats* stats, ice_arr_stats other) {
+    if (other.count == 0) {
+        return;
     }
+    
+    if (stats->count == 0) {
+        *stats = other;
+        return;
+    }
+    
+    double n1 = (double) stats->count;
+    double n2 = (double) other.count;
+    double n = n1 + n2;
+    double delta = other.mean - stats->mean;
+    
+    stats->mean += delta * (n2 / n);
+    stats->m2 += other.m2 + delta * delta * (n1 * n2 / n);
+    stats->count += other.count;
+    
+    if (other.min < stats->min) stats->min = other.min;
+    if (other.max > stats->max) stats->max = other.max;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_union(ice_arr_array a1, ice_arr_array a2) {
-    int len = 0;
-    int count = 0;
+// Sample variance (Divides by count - 1)
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_stats_variance(ice_arr_stats stats) {
+    return (stats.count > 1) ? stats.m2 / (double) (stats.count - 1) : 0;
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_stats_stddev(ice_arr_stats stats) {
+    return sqrt(ice_arr_stats_variance(stats));
+}
+
+// t-digest uses k1 scale function k(q) = compression / (2 * pi) * asin(2q - 1), Centroid can span 1 unit of k at most
+// so centroids near 0 and 1 quantiles stay small (Accurate tails) while ones near median can grow big
+#define ICE_ARR_DIGEST_PI 3.14159265358979323846
+
+static double ice_arr_digest_limit(double compression, double q) {
+    double k = compression / (2 * ICE_ARR_DIGEST_PI) * asin(2 * q - 1) + 1;
     
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) >= 1 && ice_arr_matches(a1, a1.arr[i]) >= 1) {
-            len++;
-        }
+    if (k >= compression / 4) {
+        return 1;
     }
     
-    ice_arr_array res = ice_arr_new(len);
+    return (sin(k * (2 * ICE_ARR_DIGEST_PI) / compression) + 1) / 2;
+}
+
+ICE_ARR_API ice_arr_digest ICE_ARR_CALLCONV ice_arr_digest_new(double compression) {
+    ice_arr_digest res = { 0 };
+    
+    res.compression = (compression >= 10) ? compression : 100;
+    res.capacity = (int) ceil(res.compression) + 8;
+    res.buf_capacity = res.capacity * 5;
+    res.min = HUGE_VAL;
+    res.max = -HUGE_VAL;
     
-    for (int i = 0; i < a1.len; i++) {
-        if (!(ice_arr_includes(res, a1.arr[i]) == ICE_ARR_TRUE)) {
-            res.arr[count] = a1.arr[i];
-            count++;
-        }
+    res.means = (double*) ICE_ARR_MALLOC((res.capacity * 4 + res.buf_capacity) * sizeof(double));
+    
+    if (res.means == NULL) {
+        res.capacity = 0;
+        res.buf_capacity = 0;
+        return res;
     }
     
-    for (int i = 0; i < a2.len; i++) {
-        if (!(ice_arr_includes(res, a2.arr[i]) == ICE_ARR_TRUE)) {
-            res.arr[count] = a2.arr[i];
+    res.weights = res.means + res.capacity;
+    res.scratch = res.weights + res.capacity;
+    res.buf = res.scratch + res.capacity * 2;
+    
+    return res;
+}
+
+// Merges centroids with sorted (means, weights) pairs in one pass, weights can be NULL if each weight is 1
+static void ice_arr_digest_combine(ice_arr_digest* digest, double* means, double* weights, int len) {
+    double* out_means = digest->scratch;
+    double* out_weights = digest->scratch + digest->capacity;
+    double so_far = 0;
+    double limit = ice_arr_digest_limit(digest->compression, 0);
+    double cur_mean = 0, cur_weight = 0;
+    int i = 0, j = 0, count = 0;
+    
+    if (digest->len + len == 0) {
+        return;
+    }
+    
+    for (int first = 1; i < digest->len || j < len; first = 0) {
+        double m, w;
+        
+        if (j == len || (i < digest->len && digest->means[i] <= means[j])) {
+            m = digest->means[i];
+            w = digest->weights[i];
+            i++;
+        } else {
+            m = means[j];
+            w = (weights == NULL) ? 1 : weights[j];
+            j++;
+        }
+        
+        if (first) {
+            cur_mean = m;
+            cur_weight = w;
+        } else if ((so_far + cur_weight + w) / digest->total <= limit || count == digest->capacity - 1) {
+            cur_weight += w;
+            cur_mean += (m - cur_mean) * (w / cur_weight);
+        } else {
+            out_means[count] = cur_mean;
+            out_weights[count] = cur_weight;
             count++;
+            
+            so_far += cur_weight;
+            limit = ice_arr_digest_limit(digest->compression, so_far / digest->total);
+            cur_mean = m;
+            cur_weight = w;
         }
     }
     
-    return res;
+    out_means[count] = cur_mean;
+    out_weights[count] = cur_weight;
+    count++;
+    
+    memcpy(digest->means, out_means, count * sizeof(double));
+    memcpy(digest->weights, out_weights, count * sizeof(double));
+    digest->len = count;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rotate(ice_arr_array* arr, int times) {
-    for (int i = 0; i < times; i++) {
-        int i, temp;
-        temp = arr->arr[0];
+static void ice_arr_digest_flush(ice_arr_digest* digest) {
+    if (digest->buf_len > 0) {
+        ice_arr_sort_introsort(digest->buf, digest->buf_len, NULL);
+        ice_arr_digest_combine(digest, digest->buf, NULL, digest->buf_len);
+        digest->buf_len = 0;
+    }
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_digest_push(ice_arr_digest* digest, double val) {
+    if (val != val || digest->means == NULL) {
+        return;
+    }
+    
+    if (digest->buf_len == digest->buf_capacity) {
+        ice_arr_digest_flush(digest);
+    }
+    
+    digest->buf[digest->buf_len++] = val;
+    digest->total += 1;
+    
+    if (val < digest->min) digest->min = val;
+    if (val > digest->max) digest->max = val;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_digest_push_n(ice_arr_digest* digest, double* vals, int count) {
+    for (int i = 0; i < count; i++) {
+        ice_arr_digest_push(digest, vals[i]);
+    }
+}
+
+// Adds centroids of other digest into digest (other gets compressed but otherwise unchanged)
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_digest_merge(ice_arr_digest* digest, ice_arr_digest* other) {
+    if (digest == other || digest->means == NULL) {
+        return;
+    }
+    
+    ice_arr_digest_flush(other);
+    ice_arr_digest_flush(digest);
+    
+    if (other->len == 0) {
+        return;
+    }
+    
+    digest->total += other->total;
+    ice_arr_digest_combine(digest, other->means, other->weights, other->len);
+    
+    if (other->min < digest->min) digest->min = other->min;
+    if (other->max > digest->max) digest->max = other->max;
+}
+
+// Interpolates between centroid centers, Returns NaN for empty digest
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_digest_quantile(ice_arr_digest* digest, double q) {
+    double index, center;
+    
+    ice_arr_digest_flush(digest);
+    
+    if (digest->len == 0) return NAN;
+    if (q <= 0) return digest->min;
+    if (q >= 1) return digest->max;
+    if (digest->len == 1) return digest->means[0];
+    
+    index = q * digest->total;
+    center = digest->weights[0] / 2;
+    
+    if (index < center) {
+        return digest->min + (digest->means[0] - digest->min) * (index / center);
+    }
+    
+    for (int i = 0; i < digest->len - 1; i++) {
+        double next = center + (digest->weights[i] + digest->weights[i + 1]) / 2;
         
-        for (i = 0; i < arr->len - 1; i++)  {
-            arr->arr[i] = arr->arr[i + 1];
+        if (index < next) {
+            return digest->means[i] + (digest->means[i + 1] - digest->means[i]) * ((index - center) / (next - center));
         }
-        arr->arr[i] = temp;
+        
+        center = next;
     }
+    
+    double last = digest->means[digest->len - 1];
+    double rest = digest->total - center;
+    
+    return (rest > 0) ? last + (digest->max - last) * ((index - center) / rest) : last;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_move(ice_arr_array* a1, int from_index, int elems_count, int to_index, ice_arr_array* a2) {
-    if (a1->len + elems_count - 1 >= a1->real_len) {
-        ICE_ARR_REALLOC(a1->arr, (a1->real_len + ((a1->len + elems_count - 1) - a1->real_len / 2)));
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_digest_free(ice_arr_digest digest) {
+    ICE_ARR_FREE(digest.means);
+}
+
+#if !defined(ICE_ARR_NO_FILE)
+// Binary file format: 32 bytes header then raw elements, Header size keeps payload of mapped files 32-byte aligned for SIMD loads
+// Header: "IARR" magic, version (1 byte), element type (1 byte, 1 = double, 2 = float, 3 = int32, 4 = int64, 5 = uint8), endianness of payload (1 byte, 0 = little, 1 = big),
+// element size (1 byte), 4 reserved bytes, elements count (8 bytes, little-endian) and 12 reserved bytes
+#define ICE_ARR_FILE_HEADER_SIZE 32
+#define ICE_ARR_FILE_VERSION 1
+#define ICE_ARR_FILE_TYPE_F64 1
+#define ICE_ARR_FILE_TYPE_F32 2
+#define ICE_ARR_FILE_TYPE_I32 3
+#define ICE_ARR_FILE_TYPE_I64 4
+#define ICE_ARR_FILE_TYPE_U8  5
+
+static uint8_t ice_arr_file_endian(void) {
+    uint16_t n = 1;
+    return (*(uint8_t*) &n == 1) ? 0 : 1;
+}
+
+static void ice_arr_file_header(uint8_t* header, uint64_t len, uint8_t type, size_t size) {
+    memset(header, 0, ICE_ARR_FILE_HEADER_SIZE);
+    memcpy(header, "IARR", 4);
+    header[4] = ICE_ARR_FILE_VERSION;
+    header[5] = type;
+    header[6] = ice_arr_file_endian();
+    header[7] = (uint8_t) size;
+    
+    for (int i = 0; i < 8; i++) {
+        header[12 + i] = (uint8_t) (len >> (8 * i));
     }
+}
+
+// Returns elements count stored in header, Or -1 if header is invalid or its element type isn't type
+static int ice_arr_file_len(const uint8_t* header, uint8_t type, size_t size) {
+    uint64_t len = 0;
     
-    if (a2->len + elems_count - 1 >= a2->real_len) {
-        ICE_ARR_REALLOC(a2->arr, (a2->real_len + ((a2->len + elems_count - 1) - a2->real_len / 2)));
+    if (memcmp(header, "IARR", 4) != 0 || header[4] != ICE_ARR_FILE_VERSION || header[5] != type || header[6] > 1 || header[7] != size) {
+        return -1;
     }
     
-    for (int i = 0; i < (elems_count - 1); i++) {
-        a2->arr[to_index + i] = a1->arr[from_index + i];
+    for (int i = 0; i < 8; i++) {
+        len |= (uint64_t) header[12 + i] << (8 * i);
     }
+    
+    return (len > (uint64_t) INT32_MAX) ? -1 : (int) len;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort(ice_arr_array* arr) {
-    int i, j, swapped;
-    double temp;
-    
-    for (i = 0; i < arr->len; ++i) {
-        for (j = i + 1; j < arr->len; ++j) {
-            if (arr->arr[i] < arr->arr[j]) {
-                temp = arr->arr[i];
-                arr->arr[i] = arr->arr[j];
-                arr->arr[j] = temp;
-            }
-        }
+// Gets size of file at path in bytes (64-bit on every platform with mapping backend, Otherwise limited to range of long)
+static ice_arr_bool ice_arr_file_size(const char* path, uint64_t* size) {
+#if defined(ICE_ARR_MMAP_WIN32)
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    
+    if (!GetFileAttributesExA(path, GetFileExInfoStandard, &data)) {
+        return ICE_ARR_FALSE;
+    }
+    
+    *size = ((uint64_t) data.nFileSizeHigh << 32) | (uint64_t) data.nFileSizeLow;
+    return ICE_ARR_TRUE;
+#elif defined(ICE_ARR_MMAP_POSIX)
+    struct stat st;
+    
+    if (stat(path, &st) != 0) {
+        return ICE_ARR_FALSE;
+    }
+    
+    *size = (uint64_t) st.st_size;
+    return ICE_ARR_TRUE;
+#else
+    FILE* f = fopen(path, "rb");
+    long end;
+    
+    if (f == NULL) {
+        return ICE_ARR_FALSE;
+    }
+    
+    end = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    fclose(f);
+    
+    if (end < 0) {
+        return ICE_ARR_FALSE;
     }
+    
+    *size = (uint64_t) end;
+    return ICE_ARR_TRUE;
+#endif
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort_ex(ice_arr_array* arr, ice_arr_res_func f) {
-    int i, j, swapped;
-    double temp;
-    
-    for (i = 0; i < arr->len; ++i) {
-        for (j = i + 1; j < arr->len; ++j) {
-            if ((int) f(arr->arr[i], arr->arr[j]) == 1) {
-                temp = arr->arr[i];
-                arr->arr[i] = arr->arr[j];
-                arr->arr[j] = temp;
+// Writes header and len elements of size bytes, Shared by ice_arr_save and save function of typed arrays
+static ice_arr_bool ice_arr_file_write(const char* path, const void* data, int count, uint8_t type, size_t size) {
+    uint8_t header[ICE_ARR_FILE_HEADER_SIZE];
+    FILE* f = fopen(path, "wb");
+    size_t len = (count > 0) ? (size_t) count : 0;
+    int ok;
+    
+    if (f == NULL) {
+        return ICE_ARR_FALSE;
+    }
+    
+    ice_arr_file_header(header, len, type, size);
+    
+    ok = (fwrite(header, 1, ICE_ARR_FILE_HEADER_SIZE, f) == ICE_ARR_FILE_HEADER_SIZE) &&
+         (len == 0 || fwrite(data, size, len, f) == len);
+    
+    if (fclose(f) != 0) ok = 0;
+    return ok ? ICE_ARR_TRUE : ICE_ARR_FALSE;
+}
+
+// Returns elements read from file (Allocated like arrays, Free with ice_arr_mem_free) and stores their count in len
+// Returns NULL if file can't be read, isn't valid, Holds other element type or its size doesn't match header, Payload with other endianness gets byte-swapped
+static void* ice_arr_file_read(const char* path, uint8_t type, size_t size, int* len) {
+    uint8_t header[ICE_ARR_FILE_HEADER_SIZE];
+    FILE* f = fopen(path, "rb");
+    uint8_t* res;
+    uint64_t file_size;
+    int n;
+    
+    if (f == NULL) {
+        return NULL;
+    }
+    
+    if (fread(header, 1, ICE_ARR_FILE_HEADER_SIZE, f) != ICE_ARR_FILE_HEADER_SIZE || (n = ice_arr_file_len(header, type, size)) < 0) {
+        fclose(f);
+        return NULL;
+    }
+    
+    // File size must match header length before allocating, So truncated or hostile header can't force huge allocation
+    if (ice_arr_file_size(path, &file_size) == ICE_ARR_FALSE || file_size != ICE_ARR_FILE_HEADER_SIZE + (uint64_t) n * size) {
+        fclose(f);
+        return NULL;
+    }
+    
+    res = (uint8_t*) ice_arr_mem_calloc(((n > 0) ? (size_t) n : 1) * size);
+    
+    if (res == NULL || fread(res, size, (size_t) n, f) != (size_t) n) {
+        ice_arr_mem_free(res);
+        fclose(f);
+        return NULL;
+    }
+    
+    fclose(f);
+    
+    if (header[6] != ice_arr_file_endian()) {
+        for (int i = 0; i < n; i++) {
+            uint8_t* b = res + (size_t) i * size;
+            
+            for (size_t j = 0; j < size / 2; j++) {
+                uint8_t tmp = b[j];
+                b[j] = b[size - 1 - j];
+                b[size - 1 - j] = tmp;
             }
         }
     }
+    
+    *len = n;
+    return res;
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_save(ice_arr_array arr, const char* path) {
+    return ice_arr_file_write(path, arr.arr, arr.len, ICE_ARR_FILE_TYPE_F64, sizeof(double));
+}
+
+// Returns empty array (arr is NULL) if file can't be read, isn't valid or its size doesn't match header, Payload with other endianness gets byte-swapped
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_load(const char* path) {
+    ice_arr_array res = { NULL, 0, 0 };
+    
+    res.arr = (double*) ice_arr_file_read(path, ICE_ARR_FILE_TYPE_F64, sizeof(double), &res.len);
+    res.real_len = res.len;
+    return res;
+}
+
+// Maps file read-only, Pages are loaded by OS on first access so nothing is copied
+// Returns empty view (arr is NULL) if file can't be mapped, isn't valid or was saved on machine with other endianness
+ICE_ARR_API ice_arr_view ICE_ARR_CALLCONV ice_arr_map_file(const char* path) {
+    ice_arr_view res = { NULL, 0, 1 };
+#if defined(ICE_ARR_MMAP_WIN32) || defined(ICE_ARR_MMAP_POSIX)
+    uint8_t* base;
+    uint64_t size;
+    int len;
+#endif
+    
+#if defined(ICE_ARR_MMAP_WIN32)
+    LARGE_INTEGER file_size;
+    HANDLE mapping;
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    
+    if (file == INVALID_HANDLE_VALUE) {
+        return res;
+    }
+    
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < ICE_ARR_FILE_HEADER_SIZE) {
+        CloseHandle(file);
+        return res;
+    }
+    
+    size = (uint64_t) file_size.QuadPart;
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    
+    if (mapping == NULL) {
+        return res;
+    }
+    
+    // View stays valid after closing mapping handle, It's released by UnmapViewOfFile
+    base = (uint8_t*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    
+    if (base == NULL) {
+        return res;
+    }
+#elif defined(ICE_ARR_MMAP_POSIX)
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    
+    if (fd < 0) {
+        return res;
+    }
+    
+    if (fstat(fd, &st) != 0 || st.st_size < ICE_ARR_FILE_HEADER_SIZE) {
+        close(fd);
+        return res;
+    }
+    
+    size = (uint64_t) st.st_size;
+    base = (uint8_t*) mmap(NULL, (size_t) size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    
+    if (base == (uint8_t*) MAP_FAILED) {
+        return res;
+    }
+#else
+    // No mapping backend on this platform
+    (void) path;
+    return res;
+#endif
+    
+#if defined(ICE_ARR_MMAP_WIN32) || defined(ICE_ARR_MMAP_POSIX)
+    len = ice_arr_file_len(base, ICE_ARR_FILE_TYPE_F64, sizeof(double));
+    
+    if (len < 0 || base[6] != ice_arr_file_endian() || size != ICE_ARR_FILE_HEADER_SIZE + (uint64_t) len * sizeof(double)) {
+#  if defined(ICE_ARR_MMAP_WIN32)
+        UnmapViewOfFile(base);
+#  else
+        munmap(base, (size_t) size);
+#  endif
+        return res;
+    }
+    
+    res.arr = (double*) (base + ICE_ARR_FILE_HEADER_SIZE);
+    res.len = len;
+    return res;
+#endif
 }
 
+// Unmaps file mapped by ice_arr_map_file, view must be view returned by ice_arr_map_file (Not sub-view of it)
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_unmap_file(ice_arr_view view) {
+    uint8_t* base;
+    
+    if (view.arr == NULL) {
+        return;
+    }
+    
+    base = (uint8_t*) view.arr - ICE_ARR_FILE_HEADER_SIZE;
+    
+#if defined(ICE_ARR_MMAP_WIN32)
+    UnmapViewOfFile(base);
+#elif defined(ICE_ARR_MMAP_POSIX)
+    munmap(base, ICE_ARR_FILE_HEADER_SIZE + (size_t) view.len * sizeof(double));
+#else
+    (void) base;
+#endif
+}
+#endif  // !ICE_ARR_NO_FILE
+
+// Typed arrays implementation, Reductions use 8 independent lanes so compilers vectorize them (8 floats or int32 per AVX instruction, 32 bytes per AVX2 instruction for uint8)
+// SU is type arithmetic is done in, Integer types use uint64_t so sums and element-wise math wrap around instead of signed overflow (Which is undefined behavior)
+// LOWEST and HIGHEST are range of T, Values of ice_arr_array outside of it are clamped by P##_from_array
+#define ICE_ARR_TYPED_IS_FLOAT(T) ((T) 0.5 != (T) 0)
+#define ICE_ARR_TYPED_LESS(a, b) ((a) < (b))
+
+#define ICE_ARR_IMPLEMENT_TYPED(P, T, S, SU, LOWEST, HIGHEST) \
+    static ice_arr_bool P##_grow(P* arr, int capacity) { \
+        int new_len = arr->real_len + (arr->real_len / 2); \
+        T* res; \
+        if (capacity <= arr->real_len) return ICE_ARR_TRUE; \
+        if (new_len < capacity) new_len = capacity; \
+        if (new_len < ICE_ARR_MIN_CAPACITY) new_len = ICE_ARR_MIN_CAPACITY; \
+        res = (T*) ice_arr_mem_realloc(arr->arr, arr->real_len * sizeof(T), new_len * sizeof(T)); \
+        if (res == NULL) return ICE_ARR_FALSE; \
+        arr->arr = res; \
+        arr->real_len = new_len; \
+        return ICE_ARR_TRUE; \
+    } \
+    \
+    static ice_arr_bool P##_alloc(P* res, int capacity) { \
+        *res = P##_new(0); \
+        return P##_reserve(res, capacity); \
+    } \
+    \
+    static uint64_t P##_key(T n) { \
+        return ICE_ARR_TYPED_IS_FLOAT(T) ? ice_arr_hashset_key((double) n) : (uint64_t) n; \
+    } \
+    \
+    static T P##_from_double(double n) { \
+        if (n != n) return ICE_ARR_TYPED_IS_FLOAT(T) ? (T) n : (T) 0; \
+        if (n <= (double) LOWEST) return LOWEST; \
+        if (n >= (double) HIGHEST) return HIGHEST; \
+        return (T) n; \
+    } \
+    \
+    ICE_ARR_IMPLEMENT_INTROSORT(P##_sort, T, void*, ICE_ARR_TYPED_LESS) \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_new(int len) { \
+        P res; \
+        res.arr = (T*) ice_arr_mem_calloc(((len > 0) ? len : 1) * sizeof(T)); \
+        res.len = (res.arr == NULL) ? 0 : len; \
+        res.real_len = res.len; \
+        return res; \
+    } \
+    \
+    ICE_ARR_API T ICE_ARR_CALLCONV P##_get(P arr, int index) { \
+        return (index >= 0 && index < arr.len) ? arr.arr[index] : (T) 0; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_set(P* arr, int index, T val) { \
+        if (index >= 0 && index < arr->len) arr->arr[index] = val; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_len(P arr) { \
+        return arr.len; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_pop(P* arr) { \
+        if (arr->len > 0) arr->len--; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_push(P* arr, T val) { \
+        if (arr->len >= arr->real_len) { \
+            if (P##_grow(arr, arr->len + 1) == ICE_ARR_FALSE) return; \
+        } \
+        arr->arr[arr->len++] = val; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_push_n(P* arr, T* vals, int count) { \
+        if (count <= 0) return; \
+        if (P##_grow(arr, arr->len + count) == ICE_ARR_FALSE) return; \
+        memcpy(arr->arr + arr->len, vals, count * sizeof(T)); \
+        arr->len += count; \
+    } \
+    \
+    ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV P##_reserve(P* arr, int capacity) { \
+        T* res; \
+        if (capacity <= arr->real_len) return ICE_ARR_TRUE; \
+        res = (T*) ice_arr_mem_realloc(arr->arr, arr->real_len * sizeof(T), capacity * sizeof(T)); \
+        if (res == NULL) return ICE_ARR_FALSE; \
+        arr->arr = res; \
+        arr->real_len = capacity; \
+        return ICE_ARR_TRUE; \
+    } \
+    \
+    ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV P##_shrink_to_fit(P* arr) { \
+        int len = (arr->len > 0) ? arr->len : 1; \
+        T* res; \
+        if (arr->real_len <= len) return ICE_ARR_TRUE; \
+        res = (T*) ice_arr_mem_realloc(arr->arr, arr->real_len * sizeof(T), len * sizeof(T)); \
+        if (res == NULL) return ICE_ARR_FALSE; \
+        arr->arr = res; \
+        arr->real_len = len; \
+        return ICE_ARR_TRUE; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_free(P arr) { \
+        ice_arr_mem_free(arr.arr); \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_fill(P* arr, T val) { \
+        for (int i = 0; i < arr->len; i++) arr->arr[i] = val; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_clear(P* arr) { \
+        memset(arr->arr, 0, arr->len * sizeof(T)); \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_rev(P* arr) { \
+        for (int i = 0, j = arr->len - 1; i < j; i++, j--) { \
+            T tmp = arr->arr[i]; \
+            arr->arr[i] = arr->arr[j]; \
+            arr->arr[j] = tmp; \
+        } \
+    } \
+    \
+    ICE_ARR_API S ICE_ARR_CALLCONV P##_sum(P arr) { \
+        SU lanes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 }; \
+        SU res = 0; \
+        int i = 0; \
+        for (; i + 8 <= arr.len; i += 8) { \
+            for (int j = 0; j < 8; j++) lanes[j] += (SU) arr.arr[i + j]; \
+        } \
+        for (; i < arr.len; i++) res += (SU) arr.arr[i]; \
+        for (int j = 0; j < 8; j++) res += lanes[j]; \
+        return (S) res; \
+    } \
+    \
+    ICE_ARR_API T ICE_ARR_CALLCONV P##_min(P arr) { \
+        T lanes[8] = { HIGHEST, HIGHEST, HIGHEST, HIGHEST, HIGHEST, HIGHEST, HIGHEST, HIGHEST }; \
+        T res = HIGHEST; \
+        int i = 0; \
+        for (; i + 8 <= arr.len; i += 8) { \
+            for (int j = 0; j < 8; j++) lanes[j] = (arr.arr[i + j] < lanes[j]) ? arr.arr[i + j] : lanes[j]; \
+        } \
+        for (; i < arr.len; i++) if (arr.arr[i] < res) res = arr.arr[i]; \
+        for (int j = 0; j < 8; j++) if (lanes[j] < res) res = lanes[j]; \
+        return res; \
+    } \
+    \
+    ICE_ARR_API T ICE_ARR_CALLCONV P##_max(P arr) { \
+        T lanes[8] = { LOWEST, LOWEST, LOWEST, LOWEST, LOWEST, LOWEST, LOWEST, LOWEST }; \
+        T res = LOWEST; \
+        int i = 0; \
+        for (; i + 8 <= arr.len; i += 8) { \
+            for (int j = 0; j < 8; j++) lanes[j] = (arr.arr[i + j] > lanes[j]) ? arr.arr[i + j] : lanes[j]; \
+        } \
+        for (; i < arr.len; i++) if (arr.arr[i] > res) res = arr.arr[i]; \
+        for (int j = 0; j < 8; j++) if (lanes[j] > res) res = lanes[j]; \
+        return res; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_matches(P arr, T val) { \
+        int res = 0; \
+        for (int i = 0; i < arr.len; i++) res += (arr.arr[i] == val); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV P##_includes(P arr, T val) { \
+        for (int i = 0; i < arr.len; i++) if (arr.arr[i] == val) return ICE_ARR_TRUE; \
+        return ICE_ARR_FALSE; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_first_index(P arr, T val) { \
+        for (int i = 0; i < arr.len; i++) if (arr.arr[i] == val) return i; \
+        return 0; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_last_index(P arr, T val) { \
+        for (int i = arr.len - 1; i >= 0; i--) if (arr.arr[i] == val) return i; \
+        return 0; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_concat(P a1, P a2) { \
+        P res = P##_new(a1.len + a2.len); \
+        if (res.len != a1.len + a2.len) return res; \
+        memcpy(res.arr, a1.arr, a1.len * sizeof(T)); \
+        memcpy(res.arr + a1.len, a2.arr, a2.len * sizeof(T)); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_sub(P arr, int from, int to) { \
+        P res; \
+        if (from < 0) from = 0; \
+        if (to > arr.len - 1) to = arr.len - 1; \
+        res = P##_new((from <= to) ? (to - from) + 1 : 0); \
+        if (res.len > 0) memcpy(res.arr, arr.arr + from, res.len * sizeof(T)); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_sort(P* arr) { \
+        P##_sort_asc(arr); \
+        P##_rev(arr); \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_sort_asc(P* arr) { \
+        P##_sort_introsort(arr->arr, arr->len, NULL); \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_unique(P arr) { \
+        P res; \
+        ice_arr_hashset set; \
+        if (P##_alloc(&res, arr.len) == ICE_ARR_FALSE) return res; \
+        if (ice_arr_hashset_init(&set, arr.len) == ICE_ARR_FALSE) return res; \
+        for (int i = 0; i < arr.len; i++) ice_arr_hashset_find_key(&set, P##_key(arr.arr[i]), ICE_ARR_TRUE)->count++; \
+        for (int i = 0; i < arr.len; i++) { \
+            if (ice_arr_hashset_find_key(&set, P##_key(arr.arr[i]), ICE_ARR_FALSE)->count == 1) res.arr[res.len++] = arr.arr[i]; \
+        } \
+        ICE_ARR_FREE(set.entries); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_diff(P a1, P a2) { \
+        P res; \
+        ice_arr_hashset set; \
+        if (P##_alloc(&res, a1.len) == ICE_ARR_FALSE) return res; \
+        if (ice_arr_hashset_init(&set, a2.len) == ICE_ARR_FALSE) return res; \
+        for (int i = 0; i < a2.len; i++) ice_arr_hashset_find_key(&set, P##_key(a2.arr[i]), ICE_ARR_TRUE)->count++; \
+        for (int i = 0; i < a1.len; i++) { \
+            ice_arr_hashset_entry* e = ice_arr_hashset_find_key(&set, P##_key(a1.arr[i]), ICE_ARR_FALSE); \
+            if (e != NULL && e->count == 1) res.arr[res.len++] = a1.arr[i]; \
+        } \
+        ICE_ARR_FREE(set.entries); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_except(P a1, P a2) { \
+        P res; \
+        ice_arr_hashset set; \
+        if (P##_alloc(&res, a1.len) == ICE_ARR_FALSE) return res; \
+        if (ice_arr_hashset_init(&set, a2.len) == ICE_ARR_FALSE) return res; \
+        for (int i = 0; i < a2.len; i++) ice_arr_hashset_find_key(&set, P##_key(a2.arr[i]), ICE_ARR_TRUE)->count = 1; \
+        for (int i = 0; i < a1.len; i++) { \
+            if (ice_arr_hashset_find_key(&set, P##_key(a1.arr[i]), ICE_ARR_FALSE) == NULL) res.arr[res.len++] = a1.arr[i]; \
+        } \
+        ICE_ARR_FREE(set.entries); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_intersect(P a1, P a2) { \
+        P res; \
+        ice_arr_hashset set; \
+        if (P##_alloc(&res, (a1.len < a2.len) ? a1.len : a2.len) == ICE_ARR_FALSE) return res; \
+        if (ice_arr_hashset_init(&set, a2.len) == ICE_ARR_FALSE) return res; \
+        for (int i = 0; i < a2.len; i++) ice_arr_hashset_find_key(&set, P##_key(a2.arr[i]), ICE_ARR_TRUE)->count = 1; \
+        for (int i = 0; i < a1.len; i++) { \
+            ice_arr_hashset_entry* e = ice_arr_hashset_find_key(&set, P##_key(a1.arr[i]), ICE_ARR_FALSE); \
+            if (e != NULL && e->count == 1) { \
+                res.arr[res.len++] = a1.arr[i]; \
+                e->count = -1; \
+            } \
+        } \
+        ICE_ARR_FREE(set.entries); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_union(P a1, P a2) { \
+        P res; \
+        ice_arr_hashset set; \
+        if (P##_alloc(&res, a1.len + a2.len) == ICE_ARR_FALSE) return res; \
+        if (ice_arr_hashset_init(&set, a1.len + a2.len) == ICE_ARR_FALSE) return res; \
+        for (int i = 0; i < a1.len; i++) { \
+            if (ice_arr_hashset_find_key(&set, P##_key(a1.arr[i]), ICE_ARR_TRUE)->count++ == 0) res.arr[res.len++] = a1.arr[i]; \
+        } \
+        for (int i = 0; i < a2.len; i++) { \
+            if (ice_arr_hashset_find_key(&set, P##_key(a2.arr[i]), ICE_ARR_TRUE)->count++ == 0) res.arr[res.len++] = a2.arr[i]; \
+        } \
+        ICE_ARR_FREE(set.entries); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_remove_all(P* arr, T val) { \
+        int count = 0; \
+        int removed; \
+        for (int i = 0; i < arr->len; i++) { \
+            T n = arr->arr[i]; \
+            arr->arr[count] = n; \
+            count += (n != val); \
+        } \
+        removed = arr->len - count; \
+        arr->len = count; \
+        return removed; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_compact_inplace(P* arr) { \
+        return P##_remove_all(arr, (T) 0); \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_dedup_inplace(P* arr) { \
+        ice_arr_hashset set; \
+        int count = 0; \
+        int removed; \
+        if (arr->len < 2) return 0; \
+        if (ice_arr_hashset_init(&set, arr->len) == ICE_ARR_FALSE) return -1; \
+        for (int i = 0; i < arr->len; i++) { \
+            if (ice_arr_hashset_find_key(&set, P##_key(arr->arr[i]), ICE_ARR_TRUE)->count++ == 0) arr->arr[count++] = arr->arr[i]; \
+        } \
+        ICE_ARR_FREE(set.entries); \
+        removed = arr->len - count; \
+        arr->len = count; \
+        return removed; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_filter_inplace(P* arr, P##_pred_func f) { \
+        int count = 0; \
+        int removed; \
+        for (int i = 0; i < arr->len; i++) { \
+            if (f(arr->arr[i]) == 1) arr->arr[count++] = arr->arr[i]; \
+        } \
+        removed = arr->len - count; \
+        arr->len = count; \
+        return removed; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_lower_bound(P arr, T val) { \
+        const T* base = arr.arr; \
+        int n = arr.len; \
+        if (n <= 0) return 0; \
+        while (n > 1) { \
+            int half = n / 2; \
+            base = (base[half - 1] < val) ? base + half : base; \
+            n -= half; \
+        } \
+        return (int) (base - arr.arr) + (*base < val); \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_upper_bound(P arr, T val) { \
+        const T* base = arr.arr; \
+        int n = arr.len; \
+        if (n <= 0) return 0; \
+        while (n > 1) { \
+            int half = n / 2; \
+            base = (base[half - 1] <= val) ? base + half : base; \
+            n -= half; \
+        } \
+        return (int) (base - arr.arr) + (*base <= val); \
+    } \
+    \
+    ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV P##_sorted_includes(P arr, T val) { \
+        int i = P##_lower_bound(arr, val); \
+        return (i < arr.len && arr.arr[i] == val) ? ICE_ARR_TRUE : ICE_ARR_FALSE; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_sorted_intersect(P a1, P a2) { \
+        P res; \
+        int i = 0; \
+        int j = 0; \
+        if (P##_alloc(&res, (a1.len < a2.len) ? a1.len : a2.len) == ICE_ARR_FALSE) return res; \
+        while (i < a1.len && j < a2.len) { \
+            T n = a1.arr[i]; \
+            if (n < a2.arr[j]) { \
+                i++; \
+            } else if (a2.arr[j] < n) { \
+                j++; \
+            } else { \
+                res.arr[res.len++] = n; \
+                do i++; while (i < a1.len && a1.arr[i] == n); \
+                do j++; while (j < a2.len && a2.arr[j] == n); \
+            } \
+        } \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_sorted_union(P a1, P a2) { \
+        P res; \
+        int i = 0; \
+        int j = 0; \
+        if (P##_alloc(&res, a1.len + a2.len) == ICE_ARR_FALSE) return res; \
+        while (i < a1.len || j < a2.len) { \
+            T n = (j == a2.len || (i < a1.len && !(a2.arr[j] < a1.arr[i]))) ? a1.arr[i++] : a2.arr[j++]; \
+            res.arr[res.len++] = n; \
+            while (i < a1.len && a1.arr[i] == n) i++; \
+            while (j < a2.len && a2.arr[j] == n) j++; \
+        } \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_add(P a1, P a2) { \
+        P res = P##_new((a1.len < a2.len) ? a1.len : a2.len); \
+        for (int i = 0; i < res.len; i++) res.arr[i] = (T) ((SU) a1.arr[i] + (SU) a2.arr[i]); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_add_inplace(P* a1, P a2) { \
+        int len = (a1->len < a2.len) ? a1->len : a2.len; \
+        for (int i = 0; i < len; i++) a1->arr[i] = (T) ((SU) a1->arr[i] + (SU) a2.arr[i]); \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_mul(P a1, P a2) { \
+        P res = P##_new((a1.len < a2.len) ? a1.len : a2.len); \
+        for (int i = 0; i < res.len; i++) res.arr[i] = (T) ((SU) a1.arr[i] * (SU) a2.arr[i]); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_mul_inplace(P* a1, P a2) { \
+        int len = (a1->len < a2.len) ? a1->len : a2.len; \
+        for (int i = 0; i < len; i++) a1->arr[i] = (T) ((SU) a1->arr[i] * (SU) a2.arr[i]); \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_scale(P arr, T alpha) { \
+        P res = P##_new(arr.len); \
+        for (int i = 0; i < res.len; i++) res.arr[i] = (T) ((SU) alpha * (SU) arr.arr[i]); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_scale_inplace(P* arr, T alpha) { \
+        for (int i = 0; i < arr->len; i++) arr->arr[i] = (T) ((SU) alpha * (SU) arr->arr[i]); \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_axpy(T alpha, P x, P y) { \
+        P res = P##_new((x.len < y.len) ? x.len : y.len); \
+        for (int i = 0; i < res.len; i++) res.arr[i] = (T) ((SU) alpha * (SU) x.arr[i] + (SU) y.arr[i]); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API void ICE_ARR_CALLCONV P##_axpy_inplace(T alpha, P x, P* y) { \
+        int len = (x.len < y->len) ? x.len : y->len; \
+        for (int i = 0; i < len; i++) y->arr[i] = (T) ((SU) alpha * (SU) x.arr[i] + (SU) y->arr[i]); \
+    } \
+    \
+    ICE_ARR_API S ICE_ARR_CALLCONV P##_dot(P a1, P a2) { \
+        SU lanes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 }; \
+        SU res = 0; \
+        int len = (a1.len < a2.len) ? a1.len : a2.len; \
+        int i = 0; \
+        for (; i + 8 <= len; i += 8) { \
+            for (int j = 0; j < 8; j++) lanes[j] += (SU) a1.arr[i + j] * (SU) a2.arr[i + j]; \
+        } \
+        for (; i < len; i++) res += (SU) a1.arr[i] * (SU) a2.arr[i]; \
+        for (int j = 0; j < 8; j++) res += lanes[j]; \
+        return (S) res; \
+    } \
+    \
+    ICE_ARR_API P##_view ICE_ARR_CALLCONV P##_view_of(P arr) { \
+        return (P##_view) { arr.arr, arr.len, 1 }; \
+    } \
+    \
+    ICE_ARR_API P##_view ICE_ARR_CALLCONV P##_first_view(P arr, int elems) { \
+        return P##_view_sub(P##_view_of(arr), 0, ((elems <= 1) ? 1 : elems) - 1); \
+    } \
+    \
+    ICE_ARR_API P##_view ICE_ARR_CALLCONV P##_last_view(P arr, int elems) { \
+        if (arr.len == 0) return (P##_view) { arr.arr, 0, -1 }; \
+        return P##_view_sub((P##_view) { arr.arr + arr.len - 1, arr.len, -1 }, 0, ((elems <= 1) ? 1 : elems) - 1); \
+    } \
+    \
+    ICE_ARR_API P##_view ICE_ARR_CALLCONV P##_sub_view(P arr, int from, int to) { \
+        return P##_view_sub(P##_view_of(arr), from, to); \
+    } \
+    \
+    ICE_ARR_API P##_view ICE_ARR_CALLCONV P##_tail_view(P arr) { \
+        return P##_view_sub(P##_view_of(arr), 1, arr.len - 1); \
+    } \
+    \
+    ICE_ARR_API P##_view ICE_ARR_CALLCONV P##_view_sub(P##_view view, int from, int to) { \
+        if (from < 0) from = 0; \
+        if (to > view.len - 1) to = view.len - 1; \
+        if (from > to) return (P##_view) { view.arr, 0, view.stride }; \
+        return (P##_view) { view.arr + (ptrdiff_t) from * view.stride, (to - from) + 1, view.stride }; \
+    } \
+    \
+    ICE_ARR_API P##_view ICE_ARR_CALLCONV P##_view_step(P##_view view, int step) { \
+        if (step <= 1) return view; \
+        return (P##_view) { view.arr, (view.len + step - 1) / step, view.stride * step }; \
+    } \
+    \
+    ICE_ARR_API T ICE_ARR_CALLCONV P##_view_get(P##_view view, int index) { \
+        return (index >= 0 && index < view.len) ? view.arr[(ptrdiff_t) index * view.stride] : (T) 0; \
+    } \
+    \
+    ICE_ARR_API int ICE_ARR_CALLCONV P##_view_len(P##_view view) { \
+        return view.len; \
+    } \
+    \
+    ICE_ARR_API S ICE_ARR_CALLCONV P##_view_sum(P##_view view) { \
+        SU res = 0; \
+        if (view.stride == 1) return P##_sum((P) { view.arr, view.len, view.len }); \
+        for (int i = 0; i < view.len; i++) res += (SU) view.arr[(ptrdiff_t) i * view.stride]; \
+        return (S) res; \
+    } \
+    \
+    ICE_ARR_API T ICE_ARR_CALLCONV P##_view_min(P##_view view) { \
+        T res = HIGHEST; \
+        if (view.stride == 1) return P##_min((P) { view.arr, view.len, view.len }); \
+        for (int i = 0; i < view.len; i++) { \
+            T n = view.arr[(ptrdiff_t) i * view.stride]; \
+            if (n < res) res = n; \
+        } \
+        return res; \
+    } \
+    \
+    ICE_ARR_API T ICE_ARR_CALLCONV P##_view_max(P##_view view) { \
+        T res = LOWEST; \
+        if (view.stride == 1) return P##_max((P) { view.arr, view.len, view.len }); \
+        for (int i = 0; i < view.len; i++) { \
+            T n = view.arr[(ptrdiff_t) i * view.stride]; \
+            if (n > res) res = n; \
+        } \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_view_to_array(P##_view view) { \
+        P res = P##_new(view.len); \
+        if (res.len != view.len) return res; \
+        for (int i = 0; i < view.len; i++) res.arr[i] = view.arr[(ptrdiff_t) i * view.stride]; \
+        return res; \
+    } \
+    \
+    ICE_ARR_API ice_arr_stats ICE_ARR_CALLCONV P##_stats_of(P arr) { \
+        ice_arr_stats res = ice_arr_stats_new(); \
+        double vals[256]; \
+        for (int i = 0; i < arr.len; i += 256) { \
+            int count = (arr.len - i < 256) ? arr.len - i : 256; \
+            for (int j = 0; j < count; j++) vals[j] = (double) arr.arr[i + j]; \
+            ice_arr_stats_push_n(&res, vals, count); \
+        } \
+        return res; \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_from_array(ice_arr_array arr) { \
+        P res = P##_new(arr.len); \
+        for (int i = 0; i < res.len; i++) res.arr[i] = P##_from_double(arr.arr[i]); \
+        return res; \
+    } \
+    \
+    ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV P##_to_array(P arr) { \
+        ice_arr_array res = ice_arr_new(arr.len); \
+        for (int i = 0; i < res.len; i++) res.arr[i] = (double) arr.arr[i]; \
+        return res; \
+    }
+
+// Save/load of typed arrays, FILE_TYPE is stored in header so loading file of other element type fails
+#define ICE_ARR_IMPLEMENT_TYPED_FILE(P, T, FILE_TYPE) \
+    ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV P##_save(P arr, const char* path) { \
+        return ice_arr_file_write(path, arr.arr, arr.len, FILE_TYPE, sizeof(T)); \
+    } \
+    \
+    ICE_ARR_API P ICE_ARR_CALLCONV P##_load(const char* path) { \
+        P res = { NULL, 0, 0 }; \
+        res.arr = (T*) ice_arr_file_read(path, FILE_TYPE, sizeof(T), &res.len); \
+        res.real_len = res.len; \
+        return res; \
+    }
+
+ICE_ARR_IMPLEMENT_TYPED(ice_arr_f32, float, double, double, -HUGE_VALF, HUGE_VALF)
+ICE_ARR_IMPLEMENT_TYPED(ice_arr_i32, int32_t, int64_t, uint64_t, INT32_MIN, INT32_MAX)
+ICE_ARR_IMPLEMENT_TYPED(ice_arr_i64, int64_t, int64_t, uint64_t, INT64_MIN, INT64_MAX)
+ICE_ARR_IMPLEMENT_TYPED(ice_arr_u8, uint8_t, uint64_t, uint64_t, 0, UINT8_MAX)
+
+#if !defined(ICE_ARR_NO_FILE)
+ICE_ARR_IMPLEMENT_TYPED_FILE(ice_arr_f32, float, ICE_ARR_FILE_TYPE_F32)
+ICE_ARR_IMPLEMENT_TYPED_FILE(ice_arr_i32, int32_t, ICE_ARR_FILE_TYPE_I32)
+ICE_ARR_IMPLEMENT_TYPED_FILE(ice_arr_i64, int64_t, ICE_ARR_FILE_TYPE_I64)
+ICE_ARR_IMPLEMENT_TYPED_FILE(ice_arr_u8, uint8_t, ICE_ARR_FILE_TYPE_U8)
+#endif
+
 #endif  // ICE_ARR_IMPL
 #endif  // ICE_ARR_H
@@ -575,7 +575,8 @@ ICE_CPU_API char* ICE_CPU_CALLCONV ice_cpu_name(void) {
 #elif defined(ICE_CPU_UNIX)
 ///////////////////////////////////////////////////////////////////////////////////////////
 // ICE_CPU_UNIX IMPLEMENTATION     (Android, Linux, BSD, etc...)
-///////////////////////////////////////////////////////////////////////////////////////////#include <unistd.h>
+///////////////////////////////////////////////////////////////////////////////////////////
+#include <unistd.h>
 #include <cpuid.h>
 #include <string.h>
 
@@ -186,6 +186,22 @@ THE SOFTWARE.
 #  define ICE_STR_API ICE_STR_APIDEF ICE_STR_INLINEDEF
 #endif
 
+// SIMD backends are detected from compiler flags, Define ICE_STR_NO_SIMD to use scalar code only
+#if !defined(ICE_STR_NO_SIMD)
+#  if defined(__AVX2__)
+#    define ICE_STR_AVX2
+#  elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ICE_STR_SSE2
+#  elif (defined(__ARM_NEON) || defined(_M_ARM64)) && (defined(__aarch64__) || defined(_M_ARM64))
+#    define ICE_STR_NEON
+#  endif
+#endif
+
+// Size of blocks intern pool copies strings into (Longer strings get their own block)
+#ifndef ICE_STR_INTERN_BLOCK
+#  define ICE_STR_INTERN_BLOCK 4096
+#endif
+
 // Custom memory allocators
 #ifndef ICE_STR_MALLOC
 #  define ICE_STR_MALLOC(sz) malloc(sz)
@@ -200,6 +216,8 @@ THE SOFTWARE.
 #  define ICE_STR_FREE(ptr) free(ptr)
 #endif
 
+#include <stddef.h>
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -212,6 +230,67 @@ typedef enum {
     ICE_STR_FALSE   = -1,
 } ice_str_bool;
 
+// Precompiled needle for repeated searches (Create with ice_str_searcher_new, Free with ice_str_searcher_free)
+typedef struct ice_str_searcher {
+    char* needle;       // Copy of needle
+    int len;            // Needle length
+    int offset;         // Index of second needle byte checked by candidate filter (First one is index 0)
+} ice_str_searcher;
+
+// String that carries its length so functions don't rescan it (Create with ice_str_buf_new/ice_str_buf_from, Free with ice_str_buf_free)
+// NOTE: str is always NULL-terminated so it can be passed to functions taking char*
+typedef struct ice_str_buf {
+    char* str;          // String data (NULL if allocation failed)
+    int len;            // String length
+    int capacity;       // Max length before next allocation (Allocation is capacity + 1 for NULL-terminator)
+} ice_str_buf;
+
+// Non-owning view over part of string, Doesn't allocate and isn't NULL-terminated so it must not be freed and must not outlive string it views
+typedef struct ice_str_view {
+    char* str;          // Pointer to first char of view
+    int len;            // View length
+} ice_str_view;
+
+// Splits string into tokens one at a time without allocating (Create with ice_str_tokenizer_new or ice_str_tokenizer_new_set, Doesn't need freeing)
+// NOTE: Delimiters next to each other give empty tokens, Delimiter at end of string doesn't start another token.
+typedef struct ice_str_tokenizer {
+    char* str;                  // String being split
+    int len;                    // String length
+    int pos;                    // Index where next token starts
+    char delims[16];            // First 16 delimiters (Compared with SIMD)
+    int delims_count;           // Count of distinct delimiters
+    unsigned char set[32];      // Bitset of all delimiters (256 bits)
+} ice_str_tokenizer;
+
+// String builder, ice_str_buf that is appended to and finished into char* (Create with ice_str_builder_new, Finish with ice_str_builder_finish or free with ice_str_builder_free)
+// NOTE: Builder is ice_str_buf so ice_str_buf functions can be used on it too.
+typedef ice_str_buf ice_str_builder;
+
+// Slot of intern pool hash table
+typedef struct ice_str_intern_slot {
+    char* str;                  // Canonical string (NULL for empty slot)
+    unsigned int hash;          // Hash of string
+    int len;                    // String length
+} ice_str_intern_slot;
+
+// Pool of unique strings, Interned strings are compared by pointer (Create with ice_str_intern_pool_new, Free with ice_str_intern_pool_free)
+// NOTE: Strings are copied into blocks of ICE_STR_INTERN_BLOCK bytes and never move, So returned pointers stay valid until pool is freed.
+typedef struct ice_str_intern_pool {
+    ice_str_intern_slot* slots; // Hash table (Open addressing with linear probing)
+    int count;                  // Count of interned strings
+    int capacity;               // Count of slots (Power of 2)
+    char* block;                // Current block strings are copied into (Starts with pointer to previous block)
+    int block_used;             // Bytes used in current block
+    int block_size;             // Size of current block
+} ice_str_intern_pool;
+
+// Bump allocator for short-lived strings, Bind it with ice_str_arena_bind and release everything allocated from it with ice_str_arena_reset
+typedef struct ice_str_arena {
+    struct ice_str_arena_block* blocks;     // Memory blocks (Newest first)
+    size_t block_size;                      // Size of new blocks in bytes
+    void* last;                             // Last allocation (Can be resized in place)
+} ice_str_arena;
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // ice_str FUNCTIONS
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -229,6 +308,10 @@ ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_char(char* str, int index);
 ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_match(char* s1, char* s2);                     // Returns ICE_STR_TRUE if 2 strings are same or ICE_STR_FALSE if not.
 ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_upper(char* str);                              // Returns uppercased string of str.
 ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_lower(char* str);                              // Returns lowercased string of str.
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_upper_inplace(char* str);                      // Uppercases str in place.
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_lower_inplace(char* str);                      // Lowercases str in place.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_match_nocase(char* s1, char* s2);              // Returns ICE_STR_TRUE if 2 strings are same ignoring ASCII case or ICE_STR_FALSE if not.
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_compare_nocase(char* s1, char* s2);            // Compares 2 strings ignoring ASCII case, Returns negative number if s1 sorts before s2, 0 if they are same or positive number if s1 sorts after s2.
 ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_capitalize(char* str);                         // Returns capitalized string of str.
 ICE_STR_API  char**        ICE_STR_CALLCONV  ice_str_split(char* str, char delim);                  // Split string into array by delimiter/separator (char) and return result.
 ICE_STR_API  char**        ICE_STR_CALLCONV  ice_str_splitlines(char* str);                         // Split string into array by newline char and return the array.
@@ -238,6 +321,58 @@ ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_begin(char* s1, char* s2);
 ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_end(char* s1, char* s2);                       // Returns ICE_STR_TRUE if string s1 ends with string s2 or ICE_STR_FALSE if not.
 ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_end_char(char* str, char ch);                  // Returns ICE_STR_TRUE if string ends with character or ICE_STR_FALSE if not.
 ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_rev(char* str);                                // Returns reversed string of str.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_utf8_valid(char* str);                         // Returns ICE_STR_TRUE if str is valid UTF-8 or ICE_STR_FALSE if not.
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_utf8_len(char* str);                           // Returns count of UTF-8 codepoints in str.
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_utf8_sub(char* str, int from, int to);         // Returns substring from (from -> to) codepoint index.
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_utf8_char(char* str, int index);               // Returns codepoint at index as string.
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_utf8_rev(char* str);                           // Returns str with its codepoints in reverse order.
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_find(char* str, char* sub);                     // Returns index of first occurrence of sub in str or -1 if not found.
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_rfind(char* str, char* sub);                    // Returns index of last occurrence of sub in str or -1 if not found.
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_count(char* str, char* sub);                    // Returns count of non-overlapping occurrences of sub in str.
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_replace(char* str, char* from, char* to);       // Returns str with every non-overlapping occurrence of from replaced by to.
+ICE_STR_API  ice_str_searcher ICE_STR_CALLCONV ice_str_searcher_new(char* needle);                    // Creates searcher for needle (Copies needle).
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_searcher_find(ice_str_searcher* searcher, char* str, int len);   // Returns index of first occurrence of needle in first len chars of str or -1 if not found.
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_searcher_count(ice_str_searcher* searcher, char* str, int len);  // Returns count of non-overlapping occurrences of needle in first len chars of str.
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_searcher_free(ice_str_searcher* searcher);      // Frees searcher.
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_new(int capacity);                         // Creates empty string buffer that can hold capacity chars before allocating again.
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_from(char* str);                           // Creates string buffer with copy of str.
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_from_n(char* str, int len);                // Creates string buffer with copy of first len chars of str.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_reserve(ice_str_buf* buf, int capacity);    // Grows buffer so it can hold capacity chars, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_append(ice_str_buf* buf, char* str, int len);       // Appends first len chars of str to buffer, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_sub(ice_str_buf buf, int from, int to);     // Returns substring from (from -> to) index.
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_concat(ice_str_buf b1, ice_str_buf b2);     // Joins 2 strings in one and returns result.
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_rep(ice_str_buf buf, int count);            // Returns string repeated multiple times.
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_join(ice_str_buf* bufs, int count, ice_str_buf delim);  // Joins count strings with delim between them and returns result.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_match(ice_str_buf b1, ice_str_buf b2);      // Returns ICE_STR_TRUE if 2 strings are same or ICE_STR_FALSE if not.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_begin(ice_str_buf b1, ice_str_buf b2);      // Returns ICE_STR_TRUE if string b1 starts with string b2 or ICE_STR_FALSE if not.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_end(ice_str_buf b1, ice_str_buf b2);        // Returns ICE_STR_TRUE if string b1 ends with string b2 or ICE_STR_FALSE if not.
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_find(ice_str_buf buf, ice_str_buf sub);     // Returns index of first occurrence of sub in buf or -1 if not found.
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_count(ice_str_buf buf, ice_str_buf sub);    // Returns count of non-overlapping occurrences of sub in buf.
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_replace(ice_str_buf buf, ice_str_buf from, ice_str_buf to);  // Returns buf with every non-overlapping occurrence of from replaced by to.
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_buf_release(ice_str_buf* buf);                 // Returns string of buffer (Free it with ice_str_free) and leaves buffer empty.
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_buf_free(ice_str_buf* buf);                    // Frees string buffer.
+ICE_STR_API  ice_str_tokenizer ICE_STR_CALLCONV ice_str_tokenizer_new(char* str, int len, char delim);         // Creates tokenizer that splits first len chars of str by delim.
+ICE_STR_API  ice_str_tokenizer ICE_STR_CALLCONV ice_str_tokenizer_new_set(char* str, int len, char* delims);   // Creates tokenizer that splits first len chars of str by any char of delims.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_tokenizer_next(ice_str_tokenizer* tok, ice_str_view* token);   // Gets next token into token, Returns ICE_STR_FALSE once there are no more tokens.
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_view_dup(ice_str_view view);                    // Returns NULL-terminated copy of view.
+ICE_STR_API  ice_str_builder ICE_STR_CALLCONV ice_str_builder_new(int capacity);                   // Creates empty string builder that can hold capacity chars before allocating again.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append(ice_str_builder* builder, char* str);              // Appends string, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_n(ice_str_builder* builder, char* str, int len);   // Appends first len chars of string, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_char(ice_str_builder* builder, char ch);            // Appends char, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_fmt(ice_str_builder* builder, char* fmt, ...);     // Appends printf-formatted string, Returns ICE_STR_FALSE if allocation or formatting failed.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_int(ice_str_builder* builder, long long n);        // Appends integer in decimal, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_double(ice_str_builder* builder, double n);        // Appends shortest of %.15g/%.17g that reads back as same double, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_builder_finish(ice_str_builder* builder);    // Returns built string (Free it with ice_str_free) and leaves builder empty.
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_builder_free(ice_str_builder* builder);      // Frees string builder.
+ICE_STR_API  ice_str_intern_pool ICE_STR_CALLCONV ice_str_intern_pool_new(int capacity);           // Creates empty intern pool that can hold capacity strings before growing its table.
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern(ice_str_intern_pool* pool, char* str);  // Returns canonical copy of str owned by pool, Same string always gives same pointer (NULL if allocation failed).
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_n(ice_str_intern_pool* pool, char* str, int len);     // Returns canonical copy of first len chars of str owned by pool (NULL if allocation failed).
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_find(ice_str_intern_pool* pool, char* str);           // Returns canonical copy of str if it was interned before or NULL if not (Doesn't add it).
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_intern_pool_free(ice_str_intern_pool* pool);  // Frees intern pool and all of its strings.
+ICE_STR_API  ice_str_arena ICE_STR_CALLCONV  ice_str_arena_new(size_t block_size);                // Creates arena with first memory block of block_size bytes (64 KB if 0).
+ICE_STR_API  ice_str_arena* ICE_STR_CALLCONV ice_str_arena_bind(ice_str_arena* arena);               // Binds arena to current thread (NULL to unbind), Returns previously bound arena.
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_arena_reset(ice_str_arena* arena);             // Releases all strings allocated from arena at once.
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_arena_free(ice_str_arena* arena);              // Frees arena memory (Unbinds arena if bound).
 ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_free(char* str);                               // Frees the string.
 ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_arr_free(char** arr);                          // Frees array of strings.
 
@@ -250,400 +385,1642 @@ ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_arr_free(char** arr);
 ///////////////////////////////////////////////////////////////////////////////////////////
 #if defined(ICE_STR_IMPL)
 
-// Returns length of string.
-ICE_STR_API int ICE_STR_CALLCONV ice_str_len(char* str) {
-    int len = 0;
-    while (str[len] != '\0') len++;
-    return len;
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#if defined(ICE_STR_AVX2)
+#  include <immintrin.h>
+#elif defined(ICE_STR_SSE2)
+#  include <emmintrin.h>
+#elif defined(ICE_STR_NEON)
+#  include <arm_neon.h>
+#endif
+
+// Index of lowest set bit (ctz), count of leading zero bits (clz) and count of set bits (popcount) in SIMD compare masks
+#if defined(ICE_STR_AVX2) || defined(ICE_STR_SSE2)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+static int ice_str_ctz(unsigned int x) { unsigned long i; _BitScanForward(&i, x); return (int) i; }
+static int ice_str_clz(unsigned int x) { unsigned long i; _BitScanReverse(&i, x); return 31 - (int) i; }
+static int ice_str_popcount(unsigned int x) {
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    return (int) ((((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
 }
+#  else
+static int ice_str_ctz(unsigned int x) { return __builtin_ctz(x); }
+static int ice_str_clz(unsigned int x) { return __builtin_clz(x); }
+static int ice_str_popcount(unsigned int x) { return __builtin_popcount(x); }
+#  endif
+#elif defined(ICE_STR_NEON)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+static int ice_str_ctz64(unsigned long long x) { unsigned long i; _BitScanForward64(&i, x); return (int) i; }
+static int ice_str_clz64(unsigned long long x) { unsigned long i; _BitScanReverse64(&i, x); return 63 - (int) i; }
+#  else
+static int ice_str_ctz64(unsigned long long x) { return __builtin_ctzll(x); }
+static int ice_str_clz64(unsigned long long x) { return __builtin_clzll(x); }
+#  endif
+#endif
 
-// Returns length of array of strings.
-ICE_STR_API int ICE_STR_CALLCONV ice_str_arr_len(char** arr) {
-    int arrlen = 0;
-    while (arr[arrlen] != NULL) arrlen++;
-    return arrlen;
+// Arena allocator, While arena is bound to thread every string created by ice_str is bump-allocated from it (Heap buffers growing meanwhile stay on heap)
+#if defined(_MSC_VER)
+#  define ICE_STR_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#  define ICE_STR_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+#  define ICE_STR_THREAD_LOCAL __thread
+#else
+#  define ICE_STR_THREAD_LOCAL
+#endif
+
+// Arena allocations are rounded up to 16 bytes so every allocation stays aligned for pointers and SIMD loads
+#define ICE_STR_ARENA_ALIGN(sz) (((sz) + 15) & ~((size_t) 15))
+
+struct ice_str_arena_block {
+    struct ice_str_arena_block* next;
+    size_t size;
+    size_t used;
+    size_t pad;     // Keeps data 16-bytes aligned after header on 32-bit and 64-bit platforms
+};
+
+static ICE_STR_THREAD_LOCAL ice_str_arena* ice_str_arena_bound = NULL;
+
+static char* ice_str_arena_data(struct ice_str_arena_block* block) {
+    return (char*) (block + 1);
 }
 
-// Returns substring from (from -> to) index.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_sub(char* str, int from, int to) {
-    char* res = (char*) ICE_STR_MALLOC((to - from) + 1 * sizeof(char));
-    int count = 0;
+static struct ice_str_arena_block* ice_str_arena_block_new(size_t size) {
+    struct ice_str_arena_block* block = (struct ice_str_arena_block*) ICE_STR_MALLOC(sizeof(struct ice_str_arena_block) + size);
 
-    for (int i = from; i <= to; i++) {
-        res[count] = str[i];
-        count++;
+    if (block != NULL) {
+        block->next = NULL;
+        block->size = size;
+        block->used = 0;
     }
 
-    res[count] = '\0';
-    return res;
+    return block;
 }
 
-// Returns NULL-terminates string?
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_strdup(char* str) {
-    int len = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(len + 1 * sizeof(char));
-
-    for (int i = 0; i < len; i++) {
-        res[i] = str[i];
+// Returns ICE_STR_TRUE if memory pointed by ptr is allocated from arena
+static ice_str_bool ice_str_arena_owns(ice_str_arena* arena, void* ptr) {
+    for (struct ice_str_arena_block* b = arena->blocks; b != NULL; b = b->next) {
+        char* data = ice_str_arena_data(b);
+        if ((char*) ptr >= data && (char*) ptr < data + b->size) return ICE_STR_TRUE;
     }
 
-    res[len] = '\0';
-    return res;
+    return ICE_STR_FALSE;
 }
 
-// Joins 2 strings in one and returns result.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_concat(char* s1, char* s2) {
-    int len_str1 = ice_str_len(s1);
-    int len_str2 = ice_str_len(s2);
+static void* ice_str_arena_alloc(ice_str_arena* arena, size_t size) {
+    struct ice_str_arena_block* b = arena->blocks;
+    void* res;
 
-    char* res = (char*) ICE_STR_MALLOC((len_str1 + len_str2) * sizeof(char));
-    for (int i = 0; i < len_str1; i++) {
-        res[i] = s1[i];
-    }
+    size = ICE_STR_ARENA_ALIGN(size);
+
+    // New blocks are pushed to front of list, So first block is the one with free space
+    if (b == NULL || b->size - b->used < size) {
+        size_t block_size = (size > arena->block_size) ? size : arena->block_size;
 
-    for (int i = 0; i < len_str2; i++) {
-        res[len_str1 + i] = s2[i];
+        b = ice_str_arena_block_new(block_size);
+        if (b == NULL) return NULL;
+
+        b->next = arena->blocks;
+        arena->blocks = b;
     }
 
-    res[len_str1 + len_str2] = '\0';
+    res = ice_str_arena_data(b) + b->used;
+    b->used += size;
+    arena->last = res;
+
     return res;
 }
 
-// Returns string repeated multiple times.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_rep(char* str, int count) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC((lenstr * count) + 1 * sizeof(char));
-    int times = 0;
+static void* ice_str_mem_alloc(size_t size) {
+    if (ice_str_arena_bound == NULL) {
+        return ICE_STR_MALLOC(size);
+    }
 
-    for (int i = 0; i < count; i++) {
-        for (int j = 0; j < lenstr; j++) {
-            res[(lenstr * i) + j] = str[j];
+    return ice_str_arena_alloc(ice_str_arena_bound, size);
+}
+
+static void* ice_str_mem_realloc(void* ptr, size_t old_size, size_t size) {
+    ice_str_arena* arena = ice_str_arena_bound;
+    void* res;
+
+    // Strings allocated on heap stay on heap, Only NULL and arena-owned pointers are bump-allocated
+    if (arena == NULL || (ptr != NULL && ice_str_arena_owns(arena, ptr) == ICE_STR_FALSE)) {
+        return ICE_STR_REALLOC(ptr, size);
+    }
+
+    // Last allocation can be resized in place
+    if (ptr != NULL && ptr == arena->last) {
+        struct ice_str_arena_block* b = arena->blocks;
+        size_t offset = (char*) ptr - ice_str_arena_data(b);
+
+        if (offset + ICE_STR_ARENA_ALIGN(size) <= b->size) {
+            b->used = offset + ICE_STR_ARENA_ALIGN(size);
+            return ptr;
         }
+    }
 
-        times++;
+    if (ptr != NULL && size <= old_size) {
+        return ptr;
+    }
+
+    res = ice_str_arena_alloc(arena, size);
+    if (res == NULL) return NULL;
+
+    if (ptr != NULL) {
+        memcpy(res, ptr, old_size);
     }
 
-    res[lenstr * count] = '\0';
     return res;
 }
 
-// Returns char at index as string.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_char(char* str, int index) {
-    char* c = (char*) ICE_STR_MALLOC(2 * sizeof(char));
-    c[0] = str[index];
-    c[1] = '\0';
-    return c;
+static void ice_str_mem_free(void* ptr) {
+    if (ice_str_arena_bound != NULL && ice_str_arena_owns(ice_str_arena_bound, ptr) == ICE_STR_TRUE) {
+        return;
+    }
+
+    ICE_STR_FREE(ptr);
 }
 
-// Returns ICE_STR_TRUE if 2 strings are same or ICE_STR_FALSE if not.
-ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_match(char* s1, char* s2) {
-    int len_str1 = ice_str_len(s1);
-    int len_str2 = ice_str_len(s2);
-    int matches = 0;
+// Returns index of second needle byte checked by search filter, Last byte that differs from first one (Or last byte if all are same)
+static int ice_str_search_offset(char* needle, int len) {
+    for (int i = len - 1; i > 0; i--) {
+        if (needle[i] != needle[0]) return i;
+    }
 
-    if (len_str1 != len_str2) {
-        return ICE_STR_FALSE;
+    return (len > 0) ? len - 1 : 0;
+}
+
+// Returns index of first occurrence of needle in hay starting at from, or -1
+// Candidates are positions where needle[0] and needle[offset] both match, 16/32 positions are tested per compare and only they are checked with memcmp
+static int ice_str_search(char* hay, int hay_len, char* needle, int len, int offset, int from) {
+    if (from < 0) from = 0;
+    if (len == 0) return (from <= hay_len) ? from : -1;
+    if (len > hay_len - from) return -1;
+
+    if (len == 1) {
+        char* p = (char*) memchr(hay + from, needle[0], hay_len - from);
+        return (p != NULL) ? (int) (p - hay) : -1;
     }
 
-    for (int i = 0; i < len_str1; i++) {
-        if (s1[i] == s2[i]) {
-            matches++;
+    int i = from;
+    int last = hay_len - len;
+
+#if defined(ICE_STR_AVX2)
+    __m256i first_byte = _mm256_set1_epi8(needle[0]);
+    __m256i other_byte = _mm256_set1_epi8(needle[offset]);
+
+    for (; i <= last - 31; i += 32) {
+        __m256i b0 = _mm256_loadu_si256((__m256i*) (hay + i));
+        __m256i b1 = _mm256_loadu_si256((__m256i*) (hay + i + offset));
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(b0, first_byte), _mm256_cmpeq_epi8(b1, other_byte)));
+
+        while (mask != 0) {
+            int j = i + ice_str_ctz(mask);
+            if (memcmp(hay + j, needle, len) == 0) return j;
+            mask &= mask - 1;
+        }
+    }
+#elif defined(ICE_STR_SSE2)
+    __m128i first_byte = _mm_set1_epi8(needle[0]);
+    __m128i other_byte = _mm_set1_epi8(needle[offset]);
+
+    for (; i <= last - 15; i += 16) {
+        __m128i b0 = _mm_loadu_si128((__m128i*) (hay + i));
+        __m128i b1 = _mm_loadu_si128((__m128i*) (hay + i + offset));
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(b0, first_byte), _mm_cmpeq_epi8(b1, other_byte)));
+
+        while (mask != 0) {
+            int j = i + ice_str_ctz(mask);
+            if (memcmp(hay + j, needle, len) == 0) return j;
+            mask &= mask - 1;
+        }
+    }
+#elif defined(ICE_STR_NEON)
+    uint8x16_t first_byte = vdupq_n_u8((uint8_t) needle[0]);
+    uint8x16_t other_byte = vdupq_n_u8((uint8_t) needle[offset]);
+
+    for (; i <= last - 15; i += 16) {
+        uint8x16_t b0 = vld1q_u8((uint8_t*) (hay + i));
+        uint8x16_t b1 = vld1q_u8((uint8_t*) (hay + i + offset));
+        uint8x16_t eq = vandq_u8(vceqq_u8(b0, first_byte), vceqq_u8(b1, other_byte));
+
+        // No movemask on NEON, Narrow to 4 bits per byte instead
+        unsigned long long mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+
+        while (mask != 0) {
+            int bit = ice_str_ctz64(mask);
+            int j = i + (bit >> 2);
+            if (memcmp(hay + j, needle, len) == 0) return j;
+            mask &= ~(0xFULL << bit);
         }
     }
+#else
+    // Scalar, memchr finds first byte candidates
+    while (i <= last) {
+        char* p = (char*) memchr(hay + i, needle[0], (last - i) + 1);
+        if (p == NULL) return -1;
+
+        i = (int) (p - hay);
+        if (hay[i + offset] == needle[offset] && memcmp(hay + i, needle, len) == 0) return i;
+        i++;
+    }
+#endif
+
+    for (; i <= last; i++) {
+        if (hay[i] == needle[0] && hay[i + offset] == needle[offset] && memcmp(hay + i, needle, len) == 0) return i;
+    }
 
-    return (matches == len_str1) ? ICE_STR_TRUE : ICE_STR_FALSE;
+    return -1;
 }
 
-// Returns uppercased string of str.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_upper(char* str) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(lenstr + 1 * sizeof(char));
-
-    for (int i = 0; i < lenstr; i++) {
-        if (str[i] == 'a') res[i] = 'A';
-        else if (str[i] == 'b') res[i] = 'B';
-        else if (str[i] == 'c') res[i] = 'C';
-        else if (str[i] == 'd') res[i] = 'D';
-        else if (str[i] == 'e') res[i] = 'E';
-        else if (str[i] == 'f') res[i] = 'F';
-        else if (str[i] == 'g') res[i] = 'G';
-        else if (str[i] == 'h') res[i] = 'H';
-        else if (str[i] == 'i') res[i] = 'I';
-        else if (str[i] == 'j') res[i] = 'J';
-        else if (str[i] == 'k') res[i] = 'K';
-        else if (str[i] == 'l') res[i] = 'L';
-        else if (str[i] == 'm') res[i] = 'M';
-        else if (str[i] == 'n') res[i] = 'N';
-        else if (str[i] == 'o') res[i] = 'O';
-        else if (str[i] == 'p') res[i] = 'P';
-        else if (str[i] == 'q') res[i] = 'Q';
-        else if (str[i] == 'r') res[i] = 'R';
-        else if (str[i] == 's') res[i] = 'S';
-        else if (str[i] == 't') res[i] = 'T';
-        else if (str[i] == 'u') res[i] = 'U';
-        else if (str[i] == 'v') res[i] = 'V';
-        else if (str[i] == 'w') res[i] = 'W';
-        else if (str[i] == 'x') res[i] = 'X';
-        else if (str[i] == 'y') res[i] = 'Y';
-        else if (str[i] == 'z') res[i] = 'Z';
-        else res[i] = str[i];
+// Returns index of last occurrence of needle in hay, or -1 (Same filter as ice_str_search, Blocks are scanned from end)
+static int ice_str_search_last(char* hay, int hay_len, char* needle, int len, int offset) {
+    if (len == 0) return hay_len;
+    if (len > hay_len) return -1;
+
+    int i = hay_len - len;
+
+#if defined(ICE_STR_AVX2)
+    __m256i first_byte = _mm256_set1_epi8(needle[0]);
+    __m256i other_byte = _mm256_set1_epi8(needle[offset]);
+
+    for (; i >= 31; i -= 32) {
+        __m256i b0 = _mm256_loadu_si256((__m256i*) (hay + i - 31));
+        __m256i b1 = _mm256_loadu_si256((__m256i*) (hay + i - 31 + offset));
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(b0, first_byte), _mm256_cmpeq_epi8(b1, other_byte)));
+
+        while (mask != 0) {
+            int bit = 31 - ice_str_clz(mask);
+            int j = i - 31 + bit;
+            if (memcmp(hay + j, needle, len) == 0) return j;
+            mask &= ~(1u << bit);
+        }
+    }
+#elif defined(ICE_STR_SSE2)
+    __m128i first_byte = _mm_set1_epi8(needle[0]);
+    __m128i other_byte = _mm_set1_epi8(needle[offset]);
+
+    for (; i >= 15; i -= 16) {
+        __m128i b0 = _mm_loadu_si128((__m128i*) (hay + i - 15));
+        __m128i b1 = _mm_loadu_si128((__m128i*) (hay + i - 15 + offset));
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(b0, first_byte), _mm_cmpeq_epi8(b1, other_byte)));
+
+        while (mask != 0) {
+            int bit = 31 - ice_str_clz(mask);
+            int j = i - 15 + bit;
+            if (memcmp(hay + j, needle, len) == 0) return j;
+            mask &= ~(1u << bit);
+        }
+    }
+#elif defined(ICE_STR_NEON)
+    uint8x16_t first_byte = vdupq_n_u8((uint8_t) needle[0]);
+    uint8x16_t other_byte = vdupq_n_u8((uint8_t) needle[offset]);
+
+    for (; i >= 15; i -= 16) {
+        uint8x16_t b0 = vld1q_u8((uint8_t*) (hay + i - 15));
+        uint8x16_t b1 = vld1q_u8((uint8_t*) (hay + i - 15 + offset));
+        uint8x16_t eq = vandq_u8(vceqq_u8(b0, first_byte), vceqq_u8(b1, other_byte));
+        unsigned long long mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+
+        while (mask != 0) {
+            int bit = 63 - ice_str_clz64(mask);
+            int j = i - 15 + (bit >> 2);
+            if (memcmp(hay + j, needle, len) == 0) return j;
+            mask &= ~(0xFULL << (bit & ~3));
+        }
     }
+#endif
 
-    res[lenstr] = '\0';
-    return res;
+    for (; i >= 0; i--) {
+        if (hay[i] == needle[0] && hay[i + offset] == needle[offset] && memcmp(hay + i, needle, len) == 0) return i;
+    }
+
+    return -1;
 }
 
-// Returns lowercased string of str.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_lower(char* str) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(lenstr + 1 * sizeof(char));
-
-    for (int i = 0; i < lenstr; i++) {
-        if (str[i] == 'A') res[i] = 'a';
-        else if (str[i] == 'B') res[i] = 'b';
-        else if (str[i] == 'C') res[i] = 'c';
-        else if (str[i] == 'D') res[i] = 'd';
-        else if (str[i] == 'E') res[i] = 'e';
-        else if (str[i] == 'F') res[i] = 'f';
-        else if (str[i] == 'G') res[i] = 'g';
-        else if (str[i] == 'H') res[i] = 'h';
-        else if (str[i] == 'I') res[i] = 'i';
-        else if (str[i] == 'J') res[i] = 'j';
-        else if (str[i] == 'K') res[i] = 'k';
-        else if (str[i] == 'L') res[i] = 'l';
-        else if (str[i] == 'M') res[i] = 'm';
-        else if (str[i] == 'N') res[i] = 'n';
-        else if (str[i] == 'O') res[i] = 'o';
-        else if (str[i] == 'P') res[i] = 'p';
-        else if (str[i] == 'Q') res[i] = 'q';
-        else if (str[i] == 'R') res[i] = 'r';
-        else if (str[i] == 'S') res[i] = 's';
-        else if (str[i] == 'T') res[i] = 't';
-        else if (str[i] == 'U') res[i] = 'u';
-        else if (str[i] == 'V') res[i] = 'v';
-        else if (str[i] == 'W') res[i] = 'w';
-        else if (str[i] == 'X') res[i] = 'x';
-        else if (str[i] == 'Y') res[i] = 'y';
-        else if (str[i] == 'Z') res[i] = 'z';
-        else res[i] = str[i];
+// Returns count of non-overlapping occurrences of needle in hay
+static int ice_str_search_count(char* hay, int hay_len, char* needle, int len, int offset) {
+    int count = 0;
+    int i = 0;
+
+    if (len == 0) return 0;
+
+    while ((i = ice_str_search(hay, hay_len, needle, len, offset, i)) != -1) {
+        count++;
+        i += len;
     }
 
-    res[lenstr] = '\0';
-    return res;
+    return count;
 }
 
-// Returns capitalized string of str.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_capitalize(char* str) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(lenstr + 1 * sizeof(char));
-
-    if (str[0] == 'a') res[0] = 'A';
-    else if (str[0] == 'b') res[0] = 'B';
-    else if (str[0] == 'c') res[0] = 'C';
-    else if (str[0] == 'd') res[0] = 'D';
-    else if (str[0] == 'e') res[0] = 'E';
-    else if (str[0] == 'f') res[0] = 'F';
-    else if (str[0] == 'g') res[0] = 'G';
-    else if (str[0] == 'h') res[0] = 'H';
-    else if (str[0] == 'i') res[0] = 'I';
-    else if (str[0] == 'j') res[0] = 'J';
-    else if (str[0] == 'k') res[0] = 'K';
-    else if (str[0] == 'l') res[0] = 'L';
-    else if (str[0] == 'm') res[0] = 'M';
-    else if (str[0] == 'n') res[0] = 'N';
-    else if (str[0] == 'o') res[0] = 'O';
-    else if (str[0] == 'p') res[0] = 'R';
-    else if (str[0] == 'q') res[0] = 'Q';
-    else if (str[0] == 'r') res[0] = 'R';
-    else if (str[0] == 's') res[0] = 'S';
-    else if (str[0] == 't') res[0] = 'T';
-    else if (str[0] == 'u') res[0] = 'U';
-    else if (str[0] == 'v') res[0] = 'V';
-    else if (str[0] == 'w') res[0] = 'W';
-    else if (str[0] == 'x') res[0] = 'X';
-    else if (str[0] == 'y') res[0] = 'Y';
-    else if (str[0] == 'z') res[0] = 'Z';
-    else res[0] = str[0];
-
-    for (int i = 1; i < lenstr; i++) {
-        res[i] = str[i];
+// Case conversion kernel, Flips ASCII case bit (0x20) of every char of src in [lo, hi] range and writes result to dst (dst may be src)
+// Chars outside ASCII (>= 0x80) are negative as signed bytes so SSE2/AVX2 signed compares never select them
+static void ice_str_case_kernel(char* dst, char* src, int len, char lo, char hi) {
+    int i = 0;
+
+#if defined(ICE_STR_AVX2)
+    __m256i below = _mm256_set1_epi8((char) (lo - 1));
+    __m256i above = _mm256_set1_epi8((char) (hi + 1));
+    __m256i bit = _mm256_set1_epi8(0x20);
+
+    for (; i + 32 <= len; i += 32) {
+        __m256i b = _mm256_loadu_si256((__m256i*) (src + i));
+        __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(b, below), _mm256_cmpgt_epi8(above, b));
+        _mm256_storeu_si256((__m256i*) (dst + i), _mm256_xor_si256(b, _mm256_and_si256(in_range, bit)));
+    }
+#elif defined(ICE_STR_SSE2)
+    __m128i below = _mm_set1_epi8((char) (lo - 1));
+    __m128i above = _mm_set1_epi8((char) (hi + 1));
+    __m128i bit = _mm_set1_epi8(0x20);
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i b = _mm_loadu_si128((__m128i*) (src + i));
+        __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(b, below), _mm_cmplt_epi8(b, above));
+        _mm_storeu_si128((__m128i*) (dst + i), _mm_xor_si128(b, _mm_and_si128(in_range, bit)));
     }
+#elif defined(ICE_STR_NEON)
+    uint8x16_t low = vdupq_n_u8((uint8_t) lo);
+    uint8x16_t high = vdupq_n_u8((uint8_t) hi);
+    uint8x16_t bit = vdupq_n_u8(0x20);
+
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t b = vld1q_u8((uint8_t*) (src + i));
+        uint8x16_t in_range = vandq_u8(vcgeq_u8(b, low), vcleq_u8(b, high));
+        vst1q_u8((uint8_t*) (dst + i), veorq_u8(b, vandq_u8(in_range, bit)));
+    }
+#endif
 
-    res[lenstr] = '\0';
-    return res;
+    for (; i < len; i++) {
+        char c = src[i];
+        dst[i] = (c >= lo && c <= hi) ? (char) (c ^ 0x20) : c;
+    }
 }
 
-// Split string into array by delimiter/separator (char) and return result.
-ICE_STR_API char** ICE_STR_CALLCONV ice_str_split(char* str, char delim) {
-    int arrlen = 0;
-    int count = 0;
-    int elems = 0;
-    int lenstr = ice_str_len(str);
+// Returns first index where a and b differ ignoring ASCII case, or len if first len chars are same
+static int ice_str_nocase_mismatch(char* a, char* b, int len) {
+    int i = 0;
 
-    for (int i = 0; i < lenstr; i++) {
-        if (str[i] == delim) {
-            arrlen++;
-        }
-    }
+#if defined(ICE_STR_AVX2)
+    __m256i below = _mm256_set1_epi8('A' - 1);
+    __m256i above = _mm256_set1_epi8('Z' + 1);
+    __m256i bit = _mm256_set1_epi8(0x20);
 
-    ice_str_bool last_char_not_delim = (ice_str_end_char(str, delim) == ICE_STR_FALSE) ? ICE_STR_TRUE : ICE_STR_FALSE;
+    for (; i + 32 <= len; i += 32) {
+        __m256i x = _mm256_loadu_si256((__m256i*) (a + i));
+        __m256i y = _mm256_loadu_si256((__m256i*) (b + i));
+        x = _mm256_or_si256(x, _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi8(x, below), _mm256_cmpgt_epi8(above, x)), bit));
+        y = _mm256_or_si256(y, _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi8(y, below), _mm256_cmpgt_epi8(above, y)), bit));
 
-    if (last_char_not_delim == ICE_STR_TRUE) {
-        arrlen++;
+        unsigned int mask = ~(unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (mask != 0) return i + ice_str_ctz(mask);
+    }
+#elif defined(ICE_STR_SSE2)
+    __m128i below = _mm_set1_epi8('A' - 1);
+    __m128i above = _mm_set1_epi8('Z' + 1);
+    __m128i bit = _mm_set1_epi8(0x20);
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((__m128i*) (a + i));
+        __m128i y = _mm_loadu_si128((__m128i*) (b + i));
+        x = _mm_or_si128(x, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(x, below), _mm_cmplt_epi8(x, above)), bit));
+        y = _mm_or_si128(y, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(y, below), _mm_cmplt_epi8(y, above)), bit));
+
+        unsigned int mask = (~(unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFF;
+        if (mask != 0) return i + ice_str_ctz(mask);
+    }
+#elif defined(ICE_STR_NEON)
+    uint8x16_t low = vdupq_n_u8('A');
+    uint8x16_t high = vdupq_n_u8('Z');
+    uint8x16_t bit = vdupq_n_u8(0x20);
+
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t x = vld1q_u8((uint8_t*) (a + i));
+        uint8x16_t y = vld1q_u8((uint8_t*) (b + i));
+        x = vorrq_u8(x, vandq_u8(vandq_u8(vcgeq_u8(x, low), vcleq_u8(x, high)), bit));
+        y = vorrq_u8(y, vandq_u8(vandq_u8(vcgeq_u8(y, low), vcleq_u8(y, high)), bit));
+
+        uint8x16_t ne = vmvnq_u8(vceqq_u8(x, y));
+        unsigned long long mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(ne), 4)), 0);
+        if (mask != 0) return i + (ice_str_ctz64(mask) >> 2);
     }
+#endif
 
-    int* arr_elem_lengths = (int*) ICE_STR_MALLOC(arrlen * sizeof(int));
+    for (; i < len; i++) {
+        char x = a[i];
+        char y = b[i];
+        if (x >= 'A' && x <= 'Z') x = (char) (x | 0x20);
+        if (y >= 'A' && y <= 'Z') y = (char) (y | 0x20);
+        if (x != y) return i;
+    }
 
-    for (int i = 0; i < lenstr; i++) {
-        count++;
+    return len;
+}
+
+// UTF-8 helpers, Codepoints start at every byte that isn't continuation byte (10xxxxxx)
+#define ICE_STR_UTF8_LEAD(c) (((unsigned char) (c) & 0xC0) != 0x80)
+
+// Block helpers for SIMD fast paths: ice_str_utf8_block_ascii tells if block has only ASCII bytes, ice_str_utf8_block_leads counts codepoints starting in block and ice_str_rev_block stores block bytes reversed
+#if defined(ICE_STR_AVX2)
+#  define ICE_STR_UTF8_BLOCK 32
+static int ice_str_utf8_block_ascii(char* p) {
+    return _mm256_movemask_epi8(_mm256_loadu_si256((__m256i*) p)) == 0;
+}
+
+static int ice_str_utf8_block_leads(char* p) {
+    __m256i b = _mm256_loadu_si256((__m256i*) p);
+    return ice_str_popcount((unsigned int) _mm256_movemask_epi8(_mm256_cmpgt_epi8(b, _mm256_set1_epi8(-65))));
+}
+
+static void ice_str_rev_block(char* dst, char* src) {
+    __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*) src), rev);
+    _mm256_storeu_si256((__m256i*) dst, _mm256_permute2x128_si256(b, b, 1));
+}
+#elif defined(ICE_STR_SSE2)
+#  define ICE_STR_UTF8_BLOCK 16
+static int ice_str_utf8_block_ascii(char* p) {
+    return _mm_movemask_epi8(_mm_loadu_si128((__m128i*) p)) == 0;
+}
+
+static int ice_str_utf8_block_leads(char* p) {
+    __m128i b = _mm_loadu_si128((__m128i*) p);
+    return ice_str_popcount((unsigned int) _mm_movemask_epi8(_mm_cmpgt_epi8(b, _mm_set1_epi8(-65))));
+}
+
+static void ice_str_rev_block(char* dst, char* src) {
+    __m128i b = _mm_loadu_si128((__m128i*) src);
+    b = _mm_or_si128(_mm_slli_epi16(b, 8), _mm_srli_epi16(b, 8));
+    b = _mm_shufflelo_epi16(b, _MM_SHUFFLE(0, 1, 2, 3));
+    b = _mm_shufflehi_epi16(b, _MM_SHUFFLE(0, 1, 2, 3));
+    _mm_storeu_si128((__m128i*) dst, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+#elif defined(ICE_STR_NEON)
+#  define ICE_STR_UTF8_BLOCK 16
+static int ice_str_utf8_block_ascii(char* p) {
+    return vmaxvq_u8(vld1q_u8((uint8_t*) p)) < 0x80;
+}
+
+static int ice_str_utf8_block_leads(char* p) {
+    int8x16_t b = vld1q_s8((int8_t*) p);
+    return vaddvq_u8(vshrq_n_u8(vcgtq_s8(b, vdupq_n_s8(-65)), 7));
+}
+
+static void ice_str_rev_block(char* dst, char* src) {
+    uint8x16_t b = vrev64q_u8(vld1q_u8((uint8_t*) src));
+    vst1q_u8((uint8_t*) dst, vextq_u8(b, b, 8));
+}
+#endif
+
+// Returns count of codepoints in first len bytes of str
+static int ice_str_utf8_count(char* str, int len) {
+    int i = 0;
+    int count = 0;
+
+#if defined(ICE_STR_AVX2) || defined(ICE_STR_SSE2)
+    // Lead byte compares (-1 each) are summed per lane for up to 255 blocks, Then lanes are added with SAD
+    while (i + ICE_STR_UTF8_BLOCK <= len) {
+        int blocks = (len - i) / ICE_STR_UTF8_BLOCK;
+        if (blocks > 255) blocks = 255;
+
+#  if defined(ICE_STR_AVX2)
+        __m256i acc = _mm256_setzero_si256();
+        for (int k = 0; k < blocks; k++, i += 32) {
+            acc = _mm256_sub_epi8(acc, _mm256_cmpgt_epi8(_mm256_loadu_si256((__m256i*) (str + i)), _mm256_set1_epi8(-65)));
+        }
 
-        if (str[i] == delim) {
-            arr_elem_lengths[elems] = count;
-            elems++;
+        __m256i sad = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+        __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(sad), _mm256_extracti128_si256(sad, 1));
+        count += _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+#  else
+        __m128i acc = _mm_setzero_si128();
+        for (int k = 0; k < blocks; k++, i += 16) {
+            acc = _mm_sub_epi8(acc, _mm_cmpgt_epi8(_mm_loadu_si128((__m128i*) (str + i)), _mm_set1_epi8(-65)));
         }
+
+        __m128i sum = _mm_sad_epu8(acc, _mm_setzero_si128());
+        count += _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+#  endif
+    }
+#elif defined(ICE_STR_NEON)
+    for (; i + ICE_STR_UTF8_BLOCK <= len; i += ICE_STR_UTF8_BLOCK) {
+        count += ice_str_utf8_block_leads(str + i);
     }
+#endif
 
-    if (last_char_not_delim == ICE_STR_TRUE) {
-        arr_elem_lengths[arrlen - 1] = lenstr + 1;
-        elems++;
+    for (; i < len; i++) {
+        if (ICE_STR_UTF8_LEAD(str[i])) count++;
     }
 
-    int sum = 0;
+    return count;
+}
+
+// Returns byte offset of codepoint at index in first len bytes of str, or len if str has fewer codepoints
+static int ice_str_utf8_offset(char* str, int len, int index) {
+    int i = 0;
 
-    for (int i = 0; i < elems; i++) {
-        sum += arr_elem_lengths[i];
-    }
+    if (index <= 0) return 0;
 
-    char** res = (char**) ICE_STR_MALLOC(sum * sizeof(char));
+#if defined(ICE_STR_UTF8_BLOCK)
+    // Whole blocks are skipped by their codepoint count, Only block containing wanted codepoint is scanned
+    for (; i + ICE_STR_UTF8_BLOCK <= len; i += ICE_STR_UTF8_BLOCK) {
+        int leads = ice_str_utf8_block_leads(str + i);
+        if (leads > index) break;
+        index -= leads;
+    }
+#endif
 
-    for (int i = 0; i < elems; i++) {
-        if (i == 0) {
-            res[i] = ice_str_sub(str, 0, arr_elem_lengths[i] - 2);
-        } else {
-            res[i] = ice_str_sub(str, arr_elem_lengths[i - 1], arr_elem_lengths[i] - 2);
+    for (; i < len; i++) {
+        if (ICE_STR_UTF8_LEAD(str[i])) {
+            if (index == 0) return i;
+            index--;
         }
     }
 
-    return res;
+    return len;
 }
 
-// Split string into array by newline char and return the array.
-ICE_STR_API char** ICE_STR_CALLCONV ice_str_splitlines(char* str) {
-    return ice_str_split(str, '\n');
-}
+// Returns length of valid UTF-8 sequence at start of s (Up to len bytes), or 0 if it's invalid (Overlong, surrogate, above U+10FFFF or truncated)
+static int ice_str_utf8_seq_len(unsigned char* s, int len) {
+    unsigned char c = s[0];
+    unsigned char lo = 0x80;
+    unsigned char hi = 0xBF;
+    int n;
+
+    if (c < 0x80) return 1;
+
+    if (c >= 0xC2 && c <= 0xDF) {
+        n = 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        n = 3;
+        if (c == 0xE0) lo = 0xA0;
+        else if (c == 0xED) hi = 0x9F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        n = 4;
+        if (c == 0xF0) lo = 0x90;
+        else if (c == 0xF4) hi = 0x8F;
+    } else {
+        return 0;
+    }
 
-// Joins strings from array into one string and returns it.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_join(char** strs) {
-    int arrlen = 0;
-    int strs_size = 0;
+    if (len < n || s[1] < lo || s[1] > hi) return 0;
 
-    while (strs[arrlen] != NULL) arrlen++;
+    for (int k = 2; k < n; k++) {
+        if ((s[k] & 0xC0) != 0x80) return 0;
+    }
+
+    return n;
+}
 
-    for (int i = 0; i < arrlen; i++) {
-        strs_size += ice_str_len(strs[i]);
+// Returns index of first delimiter of tokenizer in str[from, len), or len if there isn't one
+// 1 delimiter uses memchr (Vectorized by C library), Up to 16 are compared 16/32 bytes at once, More use bitset lookup
+static int ice_str_tokenizer_scan(ice_str_tokenizer* tok, int from) {
+    char* str = tok->str;
+    int len = tok->len;
+    int count = tok->delims_count;
+    int i = from;
+
+    if (count == 1) {
+        char* p = (char*) memchr(str + from, tok->delims[0], len - from);
+        return (p != NULL) ? (int) (p - str) : len;
     }
 
-    char* res = (char*) ICE_STR_MALLOC(strs_size + 1 * sizeof(char));
-    int res_s = 0;
+    if (count <= 16) {
+#if defined(ICE_STR_AVX2)
+        __m256i delims[16];
+        for (int j = 0; j < count; j++) delims[j] = _mm256_set1_epi8(tok->delims[j]);
 
-    for (int i = 0; i < arrlen; i++) {
-        int lenstr = ice_str_len(strs[i]);
+        for (; i + 32 <= len; i += 32) {
+            __m256i b = _mm256_loadu_si256((__m256i*) (str + i));
+            __m256i eq = _mm256_cmpeq_epi8(b, delims[0]);
+            for (int j = 1; j < count; j++) eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(b, delims[j]));
 
-        for (int j = 0; j < lenstr; j++) {
-            res[j + res_s] = strs[i][j];
+            unsigned int mask = (unsigned int) _mm256_movemask_epi8(eq);
+            if (mask != 0) return i + ice_str_ctz(mask);
         }
+#elif defined(ICE_STR_SSE2)
+        __m128i delims[16];
+        for (int j = 0; j < count; j++) delims[j] = _mm_set1_epi8(tok->delims[j]);
 
-        res_s += lenstr;
+        for (; i + 16 <= len; i += 16) {
+            __m128i b = _mm_loadu_si128((__m128i*) (str + i));
+            __m128i eq = _mm_cmpeq_epi8(b, delims[0]);
+            for (int j = 1; j < count; j++) eq = _mm_or_si128(eq, _mm_cmpeq_epi8(b, delims[j]));
+
+            unsigned int mask = (unsigned int) _mm_movemask_epi8(eq);
+            if (mask != 0) return i + ice_str_ctz(mask);
+        }
+#elif defined(ICE_STR_NEON)
+        uint8x16_t delims[16];
+        for (int j = 0; j < count; j++) delims[j] = vdupq_n_u8((uint8_t) tok->delims[j]);
+
+        for (; i + 16 <= len; i += 16) {
+            uint8x16_t b = vld1q_u8((uint8_t*) (str + i));
+            uint8x16_t eq = vceqq_u8(b, delims[0]);
+            for (int j = 1; j < count; j++) eq = vorrq_u8(eq, vceqq_u8(b, delims[j]));
+
+            unsigned long long mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+            if (mask != 0) return i + (ice_str_ctz64(mask) >> 2);
+        }
+#endif
     }
 
-    res[res_s] = '\0';
-    return res;
-}
+    for (; i < len; i++) {
+        unsigned char c = (unsigned char) str[i];
+        if (tok->set[c >> 3] & (1 << (c & 7))) return i;
+    }
 
-// Joins strings from array into one string and returns it.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_join_with_delim(char** strs, char delim) {
-    int count = 0;
-    int res_s = 0;
-    int arrlen = 0;
-    int strs_size = 0;
+    return len;
+}
 
-    while (strs[arrlen] != NULL) arrlen++;
+// Creates tokenizer that splits first len chars of str by delim.
+ICE_STR_API ice_str_tokenizer ICE_STR_CALLCONV ice_str_tokenizer_new(char* str, int len, char delim) {
+    char delims[2] = { delim, '\0' };
+    ice_str_tokenizer tok = ice_str_tokenizer_new_set(str, len, delims);
 
-    for (int i = 0; i < arrlen; i++) {
-        strs_size += ice_str_len(strs[i]);
+    // Set variant stops at NULL-terminator, So delim '\0' is added here
+    if (delim == '\0') {
+        tok.delims[0] = '\0';
+        tok.delims_count = 1;
+        tok.set[0] |= 1;
     }
 
-    char* res = (char*) ICE_STR_MALLOC(1 + strs_size + arrlen * sizeof(char));
+    return tok;
+}
+
+// Creates tokenizer that splits first len chars of str by any char of delims.
+ICE_STR_API ice_str_tokenizer ICE_STR_CALLCONV ice_str_tokenizer_new_set(char* str, int len, char* delims) {
+    ice_str_tokenizer tok;
 
-    for (int i = 0; i < arrlen; i++) {
-        int lstr = ice_str_len(strs[i]);
+    memset(&tok, 0, sizeof(tok));
+    tok.str = str;
+    tok.len = len;
 
-        for (int j = 0; j < lstr; j++) {
-            res[j + res_s + ((i > 0) ? 1 : 0)] = strs[i][j];
-        }
+    for (int i = 0; delims[i] != '\0'; i++) {
+        unsigned char c = (unsigned char) delims[i];
+        if (tok.set[c >> 3] & (1 << (c & 7))) continue;
 
-        if (i != 0) {
-            res[res_s] = delim;
-            res_s += lstr + count++;
-        } else {
-            res_s += lstr + count++;
-        }
+        tok.set[c >> 3] |= (unsigned char) (1 << (c & 7));
+        if (tok.delims_count < 16) tok.delims[tok.delims_count] = delims[i];
+        tok.delims_count++;
     }
 
-    res[res_s - 1] = '\0';
-    return res;
+    return tok;
 }
 
-// Returns ICE_STR_TRUE if string s1 starts with string s2 or ICE_STR_FALSE if not.
-ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_begin(char* s1, char* s2) {
-    int lenstr = ice_str_len(s2);
-    char* sub = ice_str_sub(s1, 0, lenstr - 1);
-    
-    return ice_str_match(sub, s2);
+// Gets next token into token, Returns ICE_STR_FALSE once there are no more tokens.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_tokenizer_next(ice_str_tokenizer* tok, ice_str_view* token) {
+    if (tok->pos >= tok->len) return ICE_STR_FALSE;
+
+    int end = (tok->delims_count > 0) ? ice_str_tokenizer_scan(tok, tok->pos) : tok->len;
+
+    token->str = tok->str + tok->pos;
+    token->len = end - tok->pos;
+    tok->pos = end + 1;
+    return ICE_STR_TRUE;
 }
 
-// Returns ICE_STR_TRUE if string s1 ends with string s2 or ICE_STR_FALSE if not.
-ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_end(char* s1, char* s2) {
-    int lenstr1 = ice_str_len(s1);
-    int lenstr2 = ice_str_len(s2);
+// Returns NULL-terminated copy of view.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_view_dup(ice_str_view view) {
+    char* res = (char*) ice_str_mem_alloc((view.len + 1) * sizeof(char));
+    if (res == NULL) return NULL;
 
-    char* sub = ice_str_sub(s1, lenstr1 - lenstr2, lenstr1 - 1);
-    return ice_str_match(sub, s2);
+    memcpy(res, view.str, view.len);
+    res[view.len] = '\0';
+    return res;
 }
 
-// Returns ICE_STR_TRUE if string ends with character or ICE_STR_FALSE if not.
-ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_end_char(char* str, char ch) {
-    int lenstr = ice_str_len(str);
-    return (str[lenstr - 1] == ch) ? ICE_STR_TRUE : ICE_STR_FALSE;
+// Returns length of string.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_len(char* str) {
+    return (int) strlen(str);
 }
 
-// Returns reversed string of str.
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_rev(char* str) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(lenstr * sizeof(char));
+// Returns length of array of strings.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_arr_len(char** arr) {
+    int arrlen = 0;
+    while (arr[arrlen] != NULL) arrlen++;
+    return arrlen;
+}
 
-    for (int i = 0; i < lenstr; i++) {
-        res[(lenstr - 1) - i] = str[i];
+// Returns substring from (from -> to) index.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_sub(char* str, int from, int to) {
+    char* res = (char*) ice_str_mem_alloc(((to - from) + 2) * sizeof(char));
+    int count = 0;
+
+    for (int i = from; i <= to; i++) {
+        res[count] = str[i];
+        count++;
     }
 
-    res[lenstr] = '\0';
+    res[count] = '\0';
     return res;
 }
 
+// Returns NULL-terminates string?
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_strdup(char* str) {
+    int len = ice_str_len(str);
+    char* res = (char*) ice_str_mem_alloc(len + 1 * sizeof(char));
+
+    for (int i = 0; i < len; i++) {
+        res[i] = str[i];
+    }
+
+    res[len] = '\0';
+    return res;
+}
+
+// Joins 2 strings in one and returns result.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_concat(char* s1, char* s2) {
+    int len_str1 = ice_str_len(s1);
+    int len_str2 = ice_str_len(s2);
+
+    char* res = (char*) ice_str_mem_alloc((len_str1 + len_str2 + 1) * sizeof(char));
+    if (res == NULL) return NULL;
+
+    memcpy(res, s1, len_str1);
+    memcpy(res + len_str1, s2, len_str2);
+    res[len_str1 + len_str2] = '\0';
+    return res;
+}
+
+// Returns string repeated multiple times.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_rep(char* str, int count) {
+    int lenstr = ice_str_len(str);
+    char* res = (char*) ice_str_mem_alloc((lenstr * count) + 1 * sizeof(char));
+    int times = 0;
+
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < lenstr; j++) {
+            res[(lenstr * i) + j] = str[j];
+        }
+
+        times++;
+    }
+
+    res[lenstr * count] = '\0';
+    return res;
+}
+
+// Returns char at index as string.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_char(char* str, int index) {
+    char* c = (char*) ice_str_mem_alloc(2 * sizeof(char));
+    c[0] = str[index];
+    c[1] = '\0';
+    return c;
+}
+
+// Returns ICE_STR_TRUE if 2 strings are same or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_match(char* s1, char* s2) {
+    return (strcmp(s1, s2) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Returns uppercased string of str.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_upper(char* str) {
+    int lenstr = ice_str_len(str);
+    char* res = (char*) ice_str_mem_alloc((lenstr + 1) * sizeof(char));
+    if (res == NULL) return NULL;
+
+    ice_str_case_kernel(res, str, lenstr, 'a', 'z');
+    res[lenstr] = '\0';
+    return res;
+}
+
+// Returns lowercased string of str.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_lower(char* str) {
+    int lenstr = ice_str_len(str);
+    char* res = (char*) ice_str_mem_alloc((lenstr + 1) * sizeof(char));
+    if (res == NULL) return NULL;
+
+    ice_str_case_kernel(res, str, lenstr, 'A', 'Z');
+    res[lenstr] = '\0';
+    return res;
+}
+
+// Uppercases str in place.
+ICE_STR_API void ICE_STR_CALLCONV ice_str_upper_inplace(char* str) {
+    ice_str_case_kernel(str, str, ice_str_len(str), 'a', 'z');
+}
+
+// Lowercases str in place.
+ICE_STR_API void ICE_STR_CALLCONV ice_str_lower_inplace(char* str) {
+    ice_str_case_kernel(str, str, ice_str_len(str), 'A', 'Z');
+}
+
+// Returns ICE_STR_TRUE if 2 strings are same ignoring ASCII case or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_match_nocase(char* s1, char* s2) {
+    int len_str1 = ice_str_len(s1);
+    if (len_str1 != ice_str_len(s2)) return ICE_STR_FALSE;
+
+    return (ice_str_nocase_mismatch(s1, s2, len_str1) == len_str1) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Compares 2 strings ignoring ASCII case, Returns negative number if s1 sorts before s2, 0 if they are same or positive number if s1 sorts after s2.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_compare_nocase(char* s1, char* s2) {
+    int len_str1 = ice_str_len(s1);
+    int len_str2 = ice_str_len(s2);
+
+    // NULL-terminator of shorter string is compared too so prefix sorts first
+    int i = ice_str_nocase_mismatch(s1, s2, ((len_str1 < len_str2) ? len_str1 : len_str2) + 1);
+    if (i > len_str1 || i > len_str2) return 0;
+
+    unsigned char x = (unsigned char) s1[i];
+    unsigned char y = (unsigned char) s2[i];
+    if (x >= 'A' && x <= 'Z') x |= 0x20;
+    if (y >= 'A' && y <= 'Z') y |= 0x20;
+    return (int) x - (int) y;
+}
+
+// Returns capitalized string of str.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_capitalize(char* str) {
+    int lenstr = ice_str_len(str);
+    char* res = (char*) ice_str_mem_alloc((lenstr + 1) * sizeof(char));
+    if (res == NULL) return NULL;
+
+    memcpy(res, str, lenstr + 1);
+    if (lenstr > 0) ice_str_case_kernel(res, str, 1, 'a', 'z');
+    return res;
+}
+
+// Split string into array by delimiter/separator (char) and return result.
+ICE_STR_API char** ICE_STR_CALLCONV ice_str_split(char* str, char delim) {
+    int lenstr = ice_str_len(str);
+    int count = 0;
+    ice_str_view token;
+
+    ice_str_tokenizer tok = ice_str_tokenizer_new(str, lenstr, delim);
+    while (ice_str_tokenizer_next(&tok, &token) == ICE_STR_TRUE) count++;
+
+    char** res = (char**) ice_str_mem_alloc((count + 1) * sizeof(char*));
+    if (res == NULL) return NULL;
+
+    tok = ice_str_tokenizer_new(str, lenstr, delim);
+
+    for (int i = 0; i < count; i++) {
+        ice_str_tokenizer_next(&tok, &token);
+        res[i] = ice_str_view_dup(token);
+    }
+
+    res[count] = NULL;
+    return res;
+}
+
+// Split string into array by newline char and return the array.
+ICE_STR_API char** ICE_STR_CALLCONV ice_str_splitlines(char* str) {
+    return ice_str_split(str, '\n');
+}
+
+// Joins strings from array into one string and returns it.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_join(char** strs) {
+    ice_str_builder builder = ice_str_builder_new(0);
+
+    for (int i = 0; strs[i] != NULL; i++) {
+        ice_str_builder_append(&builder, strs[i]);
+    }
+
+    return ice_str_builder_finish(&builder);
+}
+
+// Joins strings from array into one string and returns it.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_join_with_delim(char** strs, char delim) {
+    ice_str_builder builder = ice_str_builder_new(0);
+
+    for (int i = 0; strs[i] != NULL; i++) {
+        if (i > 0) ice_str_builder_append_char(&builder, delim);
+        ice_str_builder_append(&builder, strs[i]);
+    }
+
+    return ice_str_builder_finish(&builder);
+}
+
+// Returns ICE_STR_TRUE if string s1 starts with string s2 or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_begin(char* s1, char* s2) {
+    return (strncmp(s1, s2, ice_str_len(s2)) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Returns ICE_STR_TRUE if string s1 ends with string s2 or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_end(char* s1, char* s2) {
+    int lenstr1 = ice_str_len(s1);
+    int lenstr2 = ice_str_len(s2);
+
+    return (lenstr2 <= lenstr1 && memcmp(s1 + (lenstr1 - lenstr2), s2, lenstr2) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Returns ICE_STR_TRUE if string ends with character or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_end_char(char* str, char ch) {
+    int lenstr = ice_str_len(str);
+    return (lenstr > 0 && str[lenstr - 1] == ch) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Returns reversed string of str.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_rev(char* str) {
+    int lenstr = ice_str_len(str);
+    char* res = (char*) ice_str_mem_alloc((lenstr + 1) * sizeof(char));
+    int i = 0;
+    if (res == NULL) return NULL;
+
+#if defined(ICE_STR_UTF8_BLOCK)
+    for (; i + ICE_STR_UTF8_BLOCK <= lenstr; i += ICE_STR_UTF8_BLOCK) {
+        ice_str_rev_block(res + (lenstr - i - ICE_STR_UTF8_BLOCK), str + i);
+    }
+#endif
+
+    for (; i < lenstr; i++) {
+        res[(lenstr - 1) - i] = str[i];
+    }
+
+    res[lenstr] = '\0';
+    return res;
+}
+
+// Returns ICE_STR_TRUE if str is valid UTF-8 or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_utf8_valid(char* str) {
+    int lenstr = ice_str_len(str);
+    int i = 0;
+
+    while (i < lenstr) {
+        int end = lenstr;
+
+#if defined(ICE_STR_UTF8_BLOCK)
+        // ASCII blocks are skipped, Decoder only runs over blocks having non-ASCII bytes
+        if (i + ICE_STR_UTF8_BLOCK <= lenstr) {
+            if (ice_str_utf8_block_ascii(str + i)) {
+                i += ICE_STR_UTF8_BLOCK;
+                continue;
+            }
+
+            end = i + ICE_STR_UTF8_BLOCK;
+        }
+#endif
+
+        while (i < end) {
+            int n = ice_str_utf8_seq_len((unsigned char*) (str + i), lenstr - i);
+            if (n == 0) return ICE_STR_FALSE;
+            i += n;
+        }
+    }
+
+    return ICE_STR_TRUE;
+}
+
+// Returns count of UTF-8 codepoints in str.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_len(char* str) {
+    return ice_str_utf8_count(str, ice_str_len(str));
+}
+
+// Returns substring from (from -> to) codepoint index.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_utf8_sub(char* str, int from, int to) {
+    int lenstr = ice_str_len(str);
+    int start = ice_str_utf8_offset(str, lenstr, from);
+    int end = (to < from) ? start : start + ice_str_utf8_offset(str + start, lenstr - start, to - ((from > 0) ? from : 0) + 1);
+
+    char* res = (char*) ice_str_mem_alloc((end - start + 1) * sizeof(char));
+    if (res == NULL) return NULL;
+
+    memcpy(res, str + start, end - start);
+    res[end - start] = '\0';
+    return res;
+}
+
+// Returns codepoint at index as string.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_utf8_char(char* str, int index) {
+    return ice_str_utf8_sub(str, index, index);
+}
+
+// Returns str with its codepoints in reverse order.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_utf8_rev(char* str) {
+    int lenstr = ice_str_len(str);
+    int i = 0;
+
+    char* res = (char*) ice_str_mem_alloc((lenstr + 1) * sizeof(char));
+    if (res == NULL) return NULL;
+
+    while (i < lenstr) {
+        int end = lenstr;
+
+#if defined(ICE_STR_UTF8_BLOCK)
+        // ASCII blocks are reversed with byte shuffles, Other blocks are reversed codepoint by codepoint
+        if (i + ICE_STR_UTF8_BLOCK <= lenstr) {
+            if (ice_str_utf8_block_ascii(str + i)) {
+                ice_str_rev_block(res + (lenstr - i - ICE_STR_UTF8_BLOCK), str + i);
+                i += ICE_STR_UTF8_BLOCK;
+                continue;
+            }
+
+            end = i + ICE_STR_UTF8_BLOCK;
+        }
+#endif
+
+        while (i < end) {
+            int next = i + 1;
+            while (next < lenstr && !ICE_STR_UTF8_LEAD(str[next])) next++;
+
+            for (int k = i; k < next; k++) {
+                res[(lenstr - next) + (k - i)] = str[k];
+            }
+
+            i = next;
+        }
+    }
+
+    res[lenstr] = '\0';
+    return res;
+}
+
+// Returns index of first occurrence of sub in str or -1 if not found.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_find(char* str, char* sub) {
+    int len = ice_str_len(sub);
+    return ice_str_search(str, ice_str_len(str), sub, len, ice_str_search_offset(sub, len), 0);
+}
+
+// Returns index of last occurrence of sub in str or -1 if not found.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_rfind(char* str, char* sub) {
+    int len = ice_str_len(sub);
+    return ice_str_search_last(str, ice_str_len(str), sub, len, ice_str_search_offset(sub, len));
+}
+
+// Returns count of non-overlapping occurrences of sub in str.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_count(char* str, char* sub) {
+    int len = ice_str_len(sub);
+    return ice_str_search_count(str, ice_str_len(str), sub, len, ice_str_search_offset(sub, len));
+}
+
+// Returns str with every non-overlapping occurrence of from replaced by to.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_replace(char* str, char* from, char* to) {
+    int lenstr = ice_str_len(str);
+    int len_from = ice_str_len(from);
+    int len_to = ice_str_len(to);
+    int offset = ice_str_search_offset(from, len_from);
+    int count = ice_str_search_count(str, lenstr, from, len_from, offset);
+
+    char* res = (char*) ice_str_mem_alloc((lenstr + count * (len_to - len_from) + 1) * sizeof(char));
+    if (res == NULL) return NULL;
+
+    if (count == 0) {
+        memcpy(res, str, lenstr + 1);
+        return res;
+    }
+
+    int src = 0;
+    int dst = 0;
+    int i;
+
+    while ((i = ice_str_search(str, lenstr, from, len_from, offset, src)) != -1) {
+        memcpy(res + dst, str + src, i - src);
+        dst += i - src;
+        memcpy(res + dst, to, len_to);
+        dst += len_to;
+        src = i + len_from;
+    }
+
+    memcpy(res + dst, str + src, lenstr - src);
+    dst += lenstr - src;
+    res[dst] = '\0';
+    return res;
+}
+
+// Creates searcher for needle (Copies needle).
+ICE_STR_API ice_str_searcher ICE_STR_CALLCONV ice_str_searcher_new(char* needle) {
+    ice_str_searcher searcher = { NULL, 0, 0 };
+    int len = ice_str_len(needle);
+
+    searcher.needle = (char*) ICE_STR_MALLOC((len + 1) * sizeof(char));
+    if (searcher.needle == NULL) return searcher;
+
+    memcpy(searcher.needle, needle, len + 1);
+    searcher.len = len;
+    searcher.offset = ice_str_search_offset(needle, len);
+    return searcher;
+}
+
+// Returns index of first occurrence of needle in first len chars of str or -1 if not found.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_searcher_find(ice_str_searcher* searcher, char* str, int len) {
+    if (searcher->needle == NULL) return -1;
+    return ice_str_search(str, len, searcher->needle, searcher->len, searcher->offset, 0);
+}
+
+// Returns count of non-overlapping occurrences of needle in first len chars of str.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_searcher_count(ice_str_searcher* searcher, char* str, int len) {
+    if (searcher->needle == NULL) return 0;
+    return ice_str_search_count(str, len, searcher->needle, searcher->len, searcher->offset);
+}
+
+// Frees searcher.
+ICE_STR_API void ICE_STR_CALLCONV ice_str_searcher_free(ice_str_searcher* searcher) {
+    ICE_STR_FREE(searcher->needle);
+    searcher->needle = NULL;
+    searcher->len = 0;
+    searcher->offset = 0;
+}
+
+// Grows buffer to hold at least capacity chars, By 1.5x at least so appends are amortized O(1)
+static ice_str_bool ice_str_buf_grow(ice_str_buf* buf, int capacity) {
+    if (capacity <= buf->capacity && buf->str != NULL) return ICE_STR_TRUE;
+
+    int new_capacity = buf->capacity + (buf->capacity >> 1);
+    if (new_capacity < capacity) new_capacity = capacity;
+
+    char* str = (char*) ice_str_mem_realloc(buf->str, (buf->str != NULL) ? buf->capacity + 1 : 0, (new_capacity + 1) * sizeof(char));
+    if (str == NULL) return ICE_STR_FALSE;
+
+    if (buf->str == NULL) str[0] = '\0';
+    buf->str = str;
+    buf->capacity = new_capacity;
+    return ICE_STR_TRUE;
+}
+
+// Creates empty string buffer that can hold capacity chars before allocating again.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_new(int capacity) {
+    ice_str_buf buf = { NULL, 0, 0 };
+    if (capacity < 0) capacity = 0;
+
+    buf.str = (char*) ice_str_mem_alloc((capacity + 1) * sizeof(char));
+    if (buf.str == NULL) return buf;
+
+    buf.str[0] = '\0';
+    buf.capacity = capacity;
+    return buf;
+}
+
+// Creates string buffer with copy of str.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_from(char* str) {
+    return ice_str_buf_from_n(str, ice_str_len(str));
+}
+
+// Creates string buffer with copy of first len chars of str.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_from_n(char* str, int len) {
+    ice_str_buf buf = ice_str_buf_new(len);
+    if (buf.str == NULL) return buf;
+
+    memcpy(buf.str, str, len);
+    buf.str[len] = '\0';
+    buf.len = len;
+    return buf;
+}
+
+// Grows buffer so it can hold capacity chars, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_reserve(ice_str_buf* buf, int capacity) {
+    if (capacity <= buf->capacity && buf->str != NULL) return ICE_STR_TRUE;
+
+    char* str = (char*) ice_str_mem_realloc(buf->str, (buf->str != NULL) ? buf->capacity + 1 : 0, (capacity + 1) * sizeof(char));
+    if (str == NULL) return ICE_STR_FALSE;
+
+    if (buf->str == NULL) str[0] = '\0';
+    buf->str = str;
+    buf->capacity = capacity;
+    return ICE_STR_TRUE;
+}
+
+// Appends first len chars of str to buffer, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_append(ice_str_buf* buf, char* str, int len) {
+    // str may point into buffer itself, Keep its offset in case growing moves the buffer
+    int self = (buf->str != NULL && str >= buf->str && str <= buf->str + buf->len) ? (int) (str - buf->str) : -1;
+    if (ice_str_buf_grow(buf, buf->len + len) == ICE_STR_FALSE) return ICE_STR_FALSE;
+    if (self != -1) str = buf->str + self;
+
+    memmove(buf->str + buf->len, str, len);
+    buf->len += len;
+    buf->str[buf->len] = '\0';
+    return ICE_STR_TRUE;
+}
+
+// Returns substring from (from -> to) index.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_sub(ice_str_buf buf, int from, int to) {
+    if (from < 0) from = 0;
+    if (from > buf.len) from = buf.len;
+    if (to >= buf.len) to = buf.len - 1;
+
+    return ice_str_buf_from_n(buf.str + from, (to >= from) ? (to - from) + 1 : 0);
+}
+
+// Joins 2 strings in one and returns result.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_concat(ice_str_buf b1, ice_str_buf b2) {
+    ice_str_buf res = ice_str_buf_new(b1.len + b2.len);
+    if (res.str == NULL) return res;
+
+    memcpy(res.str, b1.str, b1.len);
+    memcpy(res.str + b1.len, b2.str, b2.len);
+    res.len = b1.len + b2.len;
+    res.str[res.len] = '\0';
+    return res;
+}
+
+// Returns string repeated multiple times.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_rep(ice_str_buf buf, int count) {
+    if (count < 0) count = 0;
+
+    ice_str_buf res = ice_str_buf_new(buf.len * count);
+    if (res.str == NULL) return res;
+
+    for (int i = 0; i < count; i++) {
+        memcpy(res.str + res.len, buf.str, buf.len);
+        res.len += buf.len;
+    }
+
+    res.str[res.len] = '\0';
+    return res;
+}
+
+// Joins count strings with delim between them and returns result.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_join(ice_str_buf* bufs, int count, ice_str_buf delim) {
+    int len = (count > 1) ? (count - 1) * delim.len : 0;
+
+    for (int i = 0; i < count; i++) {
+        len += bufs[i].len;
+    }
+
+    ice_str_buf res = ice_str_buf_new(len);
+    if (res.str == NULL) return res;
+
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            memcpy(res.str + res.len, delim.str, delim.len);
+            res.len += delim.len;
+        }
+
+        memcpy(res.str + res.len, bufs[i].str, bufs[i].len);
+        res.len += bufs[i].len;
+    }
+
+    res.str[res.len] = '\0';
+    return res;
+}
+
+// Returns ICE_STR_TRUE if 2 strings are same or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_match(ice_str_buf b1, ice_str_buf b2) {
+    return (b1.len == b2.len && memcmp(b1.str, b2.str, b1.len) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Returns ICE_STR_TRUE if string b1 starts with string b2 or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_begin(ice_str_buf b1, ice_str_buf b2) {
+    return (b2.len <= b1.len && memcmp(b1.str, b2.str, b2.len) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Returns ICE_STR_TRUE if string b1 ends with string b2 or ICE_STR_FALSE if not.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_end(ice_str_buf b1, ice_str_buf b2) {
+    return (b2.len <= b1.len && memcmp(b1.str + (b1.len - b2.len), b2.str, b2.len) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Returns index of first occurrence of sub in buf or -1 if not found.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_find(ice_str_buf buf, ice_str_buf sub) {
+    return ice_str_search(buf.str, buf.len, sub.str, sub.len, ice_str_search_offset(sub.str, sub.len), 0);
+}
+
+// Returns count of non-overlapping occurrences of sub in buf.
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_count(ice_str_buf buf, ice_str_buf sub) {
+    return ice_str_search_count(buf.str, buf.len, sub.str, sub.len, ice_str_search_offset(sub.str, sub.len));
+}
+
+// Returns buf with every non-overlapping occurrence of from replaced by to.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_replace(ice_str_buf buf, ice_str_buf from, ice_str_buf to) {
+    int offset = ice_str_search_offset(from.str, from.len);
+    int count = ice_str_search_count(buf.str, buf.len, from.str, from.len, offset);
+
+    ice_str_buf res = ice_str_buf_new(buf.len + count * (to.len - from.len));
+    if (res.str == NULL) return res;
+
+    int src = 0;
+    int i;
+
+    while (count > 0 && (i = ice_str_search(buf.str, buf.len, from.str, from.len, offset, src)) != -1) {
+        memcpy(res.str + res.len, buf.str + src, i - src);
+        res.len += i - src;
+        memcpy(res.str + res.len, to.str, to.len);
+        res.len += to.len;
+        src = i + from.len;
+    }
+
+    memcpy(res.str + res.len, buf.str + src, buf.len - src);
+    res.len += buf.len - src;
+    res.str[res.len] = '\0';
+    return res;
+}
+
+// Returns string of buffer (Free it with ice_str_free) and leaves buffer empty.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_buf_release(ice_str_buf* buf) {
+    char* str = buf->str;
+
+    buf->str = NULL;
+    buf->len = 0;
+    buf->capacity = 0;
+    return str;
+}
+
+// Frees string buffer.
+ICE_STR_API void ICE_STR_CALLCONV ice_str_buf_free(ice_str_buf* buf) {
+    ice_str_mem_free(buf->str);
+    buf->str = NULL;
+    buf->len = 0;
+    buf->capacity = 0;
+}
+
+// Creates empty string builder that can hold capacity chars before allocating again.
+ICE_STR_API ice_str_builder ICE_STR_CALLCONV ice_str_builder_new(int capacity) {
+    return ice_str_buf_new(capacity);
+}
+
+// Appends string, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append(ice_str_builder* builder, char* str) {
+    return ice_str_buf_append(builder, str, ice_str_len(str));
+}
+
+// Appends first len chars of string, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_n(ice_str_builder* builder, char* str, int len) {
+    return ice_str_buf_append(builder, str, len);
+}
+
+// Appends char, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_char(ice_str_builder* builder, char ch) {
+    if (ice_str_buf_grow(builder, builder->len + 1) == ICE_STR_FALSE) return ICE_STR_FALSE;
+
+    builder->str[builder->len++] = ch;
+    builder->str[builder->len] = '\0';
+    return ICE_STR_TRUE;
+}
+
+// Appends printf-formatted string, Returns ICE_STR_FALSE if allocation or formatting failed.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_fmt(ice_str_builder* builder, char* fmt, ...) {
+    va_list args;
+
+    // Format into spare capacity first, Only format again if it didn't fit
+    if (ice_str_buf_grow(builder, builder->len) == ICE_STR_FALSE) return ICE_STR_FALSE;
+
+    va_start(args, fmt);
+    int len = vsnprintf(builder->str + builder->len, (builder->capacity - builder->len) + 1, fmt, args);
+    va_end(args);
+
+    if (len < 0) {
+        builder->str[builder->len] = '\0';
+        return ICE_STR_FALSE;
+    }
+
+    if (len > builder->capacity - builder->len) {
+        if (ice_str_buf_grow(builder, builder->len + len) == ICE_STR_FALSE) {
+            builder->str[builder->len] = '\0';
+            return ICE_STR_FALSE;
+        }
+
+        va_start(args, fmt);
+        vsnprintf(builder->str + builder->len, len + 1, fmt, args);
+        va_end(args);
+    }
+
+    builder->len += len;
+    return ICE_STR_TRUE;
+}
+
+// Appends integer in decimal, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_int(ice_str_builder* builder, long long n) {
+    char digits[24];
+    int count = 0;
+
+    // Negate as unsigned so LLONG_MIN doesn't overflow
+    unsigned long long u = (n < 0) ? 0ULL - (unsigned long long) n : (unsigned long long) n;
+
+    do {
+        digits[sizeof(digits) - 1 - count++] = (char) ('0' + (u % 10));
+        u /= 10;
+    } while (u != 0);
+
+    if (n < 0) digits[sizeof(digits) - 1 - count++] = '-';
+    return ice_str_buf_append(builder, digits + sizeof(digits) - count, count);
+}
+
+// Appends shortest of %.15g/%.17g that reads back as same double, Returns ICE_STR_FALSE if allocation failed.
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_double(ice_str_builder* builder, double n) {
+    char digits[32];
+    int len = snprintf(digits, sizeof(digits), "%.15g", n);
+
+    if (strtod(digits, NULL) != n && n == n) {
+        len = snprintf(digits, sizeof(digits), "%.17g", n);
+    }
+
+    return ice_str_buf_append(builder, digits, len);
+}
+
+// Returns built string (Free it with ice_str_free) and leaves builder empty.
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_builder_finish(ice_str_builder* builder) {
+    return ice_str_buf_release(builder);
+}
+
+// Frees string builder.
+ICE_STR_API void ICE_STR_CALLCONV ice_str_builder_free(ice_str_builder* builder) {
+    ice_str_buf_free(builder);
+}
+
+// Hash for intern pool, Mixes 8 bytes per step
+static unsigned long long ice_str_hash(char* str, int len) {
+    unsigned long long h = 0x9E3779B97F4A7C15ULL ^ (unsigned long long) len;
+    unsigned long long k;
+    int i = 0;
+
+    for (; i + 8 <= len; i += 8) {
+        memcpy(&k, str + i, 8);
+        h = (h ^ k) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+    }
+
+    k = 0;
+    memcpy(&k, str + i, len - i);
+    h = (h ^ k) * 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 29;
+    return h;
+}
+
+// Returns slot of string in table, Either slot holding it or empty slot where it would go (Capacity is power of 2 and table is never full)
+static ice_str_intern_slot* ice_str_intern_slot_of(ice_str_intern_slot* slots, int capacity, char* str, int len, unsigned int hash) {
+    unsigned int mask = (unsigned int) capacity - 1;
+    unsigned int i = hash & mask;
+
+    while (slots[i].str != NULL) {
+        if (slots[i].hash == hash && slots[i].len == len && memcmp(slots[i].str, str, len) == 0) break;
+        i = (i + 1) & mask;
+    }
+
+    return &slots[i];
+}
+
+// Doubles table capacity, Strings don't move so pointers returned before stay valid
+static ice_str_bool ice_str_intern_grow(ice_str_intern_pool* pool) {
+    int capacity = (pool->capacity > 0) ? pool->capacity * 2 : 64;
+    ice_str_intern_slot* slots = (ice_str_intern_slot*) ICE_STR_CALLOC(capacity, sizeof(ice_str_intern_slot));
+    if (slots == NULL) return ICE_STR_FALSE;
+
+    for (int i = 0; i < pool->capacity; i++) {
+        ice_str_intern_slot* slot = &pool->slots[i];
+        if (slot->str != NULL) *ice_str_intern_slot_of(slots, capacity, slot->str, slot->len, slot->hash) = *slot;
+    }
+
+    ICE_STR_FREE(pool->slots);
+    pool->slots = slots;
+    pool->capacity = capacity;
+    return ICE_STR_TRUE;
+}
+
+// Copies string into pool blocks, Block starts with pointer to previous block so they can be freed
+static char* ice_str_intern_store(ice_str_intern_pool* pool, char* str, int len) {
+    if (pool->block == NULL || pool->block_used + len + 1 > pool->block_size) {
+        int size = ICE_STR_INTERN_BLOCK;
+        if (size < (int) sizeof(char*) + len + 1) size = (int) sizeof(char*) + len + 1;
+
+        char* block = (char*) ICE_STR_MALLOC(size);
+        if (block == NULL) return NULL;
+
+        memcpy(block, &pool->block, sizeof(char*));
+        pool->block = block;
+        pool->block_used = (int) sizeof(char*);
+        pool->block_size = size;
+    }
+
+    char* res = pool->block + pool->block_used;
+    memcpy(res, str, len);
+    res[len] = '\0';
+    pool->block_used += len + 1;
+    return res;
+}
+
+// Creates empty intern pool that can hold capacity strings before growing its table.
+ICE_STR_API ice_str_intern_pool ICE_STR_CALLCONV ice_str_intern_pool_new(int capacity) {
+    ice_str_intern_pool pool;
+    int slots = 64;
+
+    memset(&pool, 0, sizeof(pool));
+    while (slots / 4 * 3 < capacity) slots *= 2;
+
+    pool.slots = (ice_str_intern_slot*) ICE_STR_CALLOC(slots, sizeof(ice_str_intern_slot));
+    if (pool.slots != NULL) pool.capacity = slots;
+    return pool;
+}
+
+// Returns canonical copy of str owned by pool, Same string always gives same pointer (NULL if allocation failed).
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern(ice_str_intern_pool* pool, char* str) {
+    return ice_str_intern_n(pool, str, ice_str_len(str));
+}
+
+// Returns canonical copy of first len chars of str owned by pool (NULL if allocation failed).
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_n(ice_str_intern_pool* pool, char* str, int len) {
+    unsigned int hash = (unsigned int) ice_str_hash(str, len);
+
+    if (pool->capacity > 0) {
+        ice_str_intern_slot* slot = ice_str_intern_slot_of(pool->slots, pool->capacity, str, len, hash);
+        if (slot->str != NULL) return slot->str;
+    }
+
+    // Keep load factor under 3/4 so probes stay short
+    if ((pool->count + 1) * 4 > pool->capacity * 3) {
+        if (ice_str_intern_grow(pool) == ICE_STR_FALSE) return NULL;
+    }
+
+    char* res = ice_str_intern_store(pool, str, len);
+    if (res == NULL) return NULL;
+
+    ice_str_intern_slot* slot = ice_str_intern_slot_of(pool->slots, pool->capacity, str, len, hash);
+    slot->str = res;
+    slot->hash = hash;
+    slot->len = len;
+    pool->count++;
+    return res;
+}
+
+// Returns canonical copy of str if it was interned before or NULL if not (Doesn't add it).
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_find(ice_str_intern_pool* pool, char* str) {
+    if (pool->capacity == 0) return NULL;
+
+    int len = ice_str_len(str);
+    return ice_str_intern_slot_of(pool->slots, pool->capacity, str, len, (unsigned int) ice_str_hash(str, len))->str;
+}
+
+// Frees intern pool and all of its strings.
+ICE_STR_API void ICE_STR_CALLCONV ice_str_intern_pool_free(ice_str_intern_pool* pool) {
+    char* block = pool->block;
+
+    while (block != NULL) {
+        char* prev;
+        memcpy(&prev, block, sizeof(char*));
+        ICE_STR_FREE(block);
+        block = prev;
+    }
+
+    ICE_STR_FREE(pool->slots);
+    memset(pool, 0, sizeof(*pool));
+}
+
+// Creates arena with first memory block of block_size bytes (64 KB if 0).
+ICE_STR_API ice_str_arena ICE_STR_CALLCONV ice_str_arena_new(size_t block_size) {
+    ice_str_arena res = { NULL, ICE_STR_ARENA_ALIGN((block_size > 0) ? block_size : 65536), NULL };
+    res.blocks = ice_str_arena_block_new(res.block_size);
+    return res;
+}
+
+// Binds arena to current thread (NULL to unbind), Returns previously bound arena.
+ICE_STR_API ice_str_arena* ICE_STR_CALLCONV ice_str_arena_bind(ice_str_arena* arena) {
+    ice_str_arena* prev = ice_str_arena_bound;
+    ice_str_arena_bound = arena;
+    return prev;
+}
+
+// Releases all strings allocated from arena at once, If arena needed multiple blocks they get merged into one so next use doesn't allocate
+ICE_STR_API void ICE_STR_CALLCONV ice_str_arena_reset(ice_str_arena* arena) {
+    struct ice_str_arena_block* b = arena->blocks;
+
+    arena->last = NULL;
+
+    if (b == NULL) return;
+
+    if (b->next != NULL) {
+        size_t total = 0;
+
+        while (b != NULL) {
+            struct ice_str_arena_block* next = b->next;
+            total += b->size;
+            ICE_STR_FREE(b);
+            b = next;
+        }
+
+        arena->block_size = total;
+        arena->blocks = ice_str_arena_block_new(total);
+        return;
+    }
+
+    b->used = 0;
+}
+
+// Frees arena memory (Unbinds arena if bound).
+ICE_STR_API void ICE_STR_CALLCONV ice_str_arena_free(ice_str_arena* arena) {
+    struct ice_str_arena_block* b = arena->blocks;
+
+    if (ice_str_arena_bound == arena) {
+        ice_str_arena_bound = NULL;
+    }
+
+    while (b != NULL) {
+        struct ice_str_arena_block* next = b->next;
+        ICE_STR_FREE(b);
+        b = next;
+    }
+
+    arena->blocks = NULL;
+    arena->last = NULL;
+}
+
 // Frees the string.
 ICE_STR_API void ICE_STR_CALLCONV ice_str_free(char* str) {
-    ICE_STR_FREE(str);
+    ice_str_mem_free(str);
     str = NULL;
 }
 
 // Frees array of strings.
 ICE_STR_API void ICE_STR_CALLCONV ice_str_arr_free(char** arr) {
-    for (int i = 0; i < ice_str_arr_len(arr); i++) {
-        ICE_STR_FREE(arr[i]);
-        arr[i] = NULL;
+    for (int i = 0; arr[i] != NULL; i++) {
+        ice_str_mem_free(arr[i]);
     }
     
-    ICE_STR_FREE(arr);
+    ice_str_mem_free(arr);
     arr = NULL;
 }
 
@@ -0,0 +1,476 @@
+// Benchmark for ice_arr.h functions over sizes from 16 to 16M elements
+// Prints CSV to stdout: function,elements,iterations,ns_total,ns_per_element,allocations
+// elements is input array length, ns_per_element is ns_total / (iterations * elements)
+// and allocations is average count of allocator calls made by one iteration
+// Usage: ice_arr_bench [max_elements]
+// Monotonic clock: QueryPerformanceCounter on Windows, clock_gettime elsewhere (Needs POSIX declarations when built with -std=c99)
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+static long long bench_allocs = 0;
+
+static void* bench_malloc(size_t size)               { bench_allocs++; return malloc(size); }
+static void* bench_calloc(size_t count, size_t size) { bench_allocs++; return calloc(count, size); }
+static void* bench_realloc(void* ptr, size_t size)   { bench_allocs++; return realloc(ptr, size); }
+
+#define ICE_ARR_MALLOC(size)        bench_malloc(size)
+#define ICE_ARR_CALLOC(count, size) bench_calloc(count, size)
+#define ICE_ARR_REALLOC(ptr, size)  bench_realloc(ptr, size)
+#define ICE_ARR_FREE(ptr)           free(ptr)
+
+#define ICE_ARR_IMPL
+#include "ice_arr.h"
+
+#define BENCH_MIN_SIZE      16
+#define BENCH_MAX_SIZE      (16 * 1024 * 1024)
+#define BENCH_TARGET_NS     20000000.0      // Repeat each case until ~20ms has been measured
+#define BENCH_WALL_NS       100000000.0     // ...or until 100ms passed including untimed setup
+#define BENCH_BUDGET_NS     2000000000.0    // Skip larger sizes once one call takes longer than 2s
+#define BENCH_MAX_CASES     128
+
+typedef void (*bench_func)(int n);
+
+typedef struct bench_case {
+    const char* name;
+    bench_func setup;   // Called before every timed call, not measured (may be NULL)
+    bench_func run;     // Measured call
+    int skip;           // Set once a call exceeded BENCH_BUDGET_NS
+} bench_case;
+
+// Shared inputs, rebuilt for every size
+static ice_arr_array a, b, work, sink, sorted, eyt;
+static ice_arr_ring ring;
+static ice_arr_arena arena;
+static ice_arr_f32 f32;
+static ice_arr_i32 i32;
+static ice_arr_i64 i64;
+static ice_arr_u8 u8;
+static volatile double dsink;
+static volatile int isink;
+
+static double bench_now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER now, freq;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&freq);
+    return (double) now.QuadPart * 1e9 / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#endif
+}
+
+static unsigned int bench_seed = 12345;
+
+static double bench_rand(int range) {
+    bench_seed = bench_seed * 1103515245u + 12345u;
+    return (double) ((bench_seed >> 8) % (unsigned int) range);
+}
+
+static void bench_iter(double val) { dsink = val; }
+static void bench_iter_ctx(void* ctx, int index, double val) { (void) index; *(double*) ctx += val; }
+static void bench_chunk(void* ctx, int index, double* arr, int len) { double s = 0; (void) index; for (int i = 0; i < len; i++) s += arr[i]; *(double*) ctx += s; }
+static int bench_desc(double a, double b) { return (a > b) ? 1 : 0; }
+
+// Setup helpers
+static void setup_work(int n) { memcpy(work.arr, a.arr, n * sizeof(double)); work.len = n; }
+static void setup_free_sink(int n) { (void) n; ice_arr_free(sink); sink = (ice_arr_array) { NULL, 0, 0 }; }
+static void setup_ring(int n) {
+    ice_arr_ring_free(ring);
+    ring = ice_arr_ring_new(n);
+    for (int i = 0; i < n; i++) ice_arr_ring_push_back(&ring, a.arr[i]);
+}
+
+#define BENCH_RESULT(expr) do { ice_arr_free(sink); sink = (expr); } while (0)
+
+// Basic access
+static void run_new(int n)      { BENCH_RESULT(ice_arr_new(n)); }
+static void run_get(int n)      { double s = 0; for (int i = 0; i < n; i++) s += ice_arr_get(a, i); dsink = s; }
+static void run_set(int n)      { for (int i = 0; i < n; i++) ice_arr_set(&work, i, i); }
+static void run_len(int n)      { int s = 0; for (int i = 0; i < n; i++) s += ice_arr_len(a); isink = s; }
+static void run_push(int n)     { ice_arr_array t = ice_arr_new(0); for (int i = 0; i < n; i++) ice_arr_push(&t, i); ice_arr_free(t); }
+static void run_push_n(int n)   { ice_arr_array t = ice_arr_new(0); ice_arr_push_n(&t, a.arr, n); ice_arr_free(t); }
+static void run_reserve(int n)  { ice_arr_array t = ice_arr_new(0); ice_arr_reserve(&t, n); ice_arr_free(t); }
+static void run_shrink(int n)   { (void) n; ice_arr_reserve(&work, work.len * 2); ice_arr_shrink_to_fit(&work); }
+static void run_pop(int n)      { for (int i = 0; i < n; i++) ice_arr_pop(&work); }
+static void run_shift(int n)    { for (int i = 0; i < n && i < 256; i++) ice_arr_shift(&work); }
+static void run_rem(int n)      { for (int i = 0; i < n && i < 256; i++) ice_arr_rem(&work, 0); }
+static void run_rev(int n)      { (void) n; ice_arr_rev(&work); }
+static void run_fill(int n)     { (void) n; ice_arr_fill(&work, 1.0); }
+static void run_clear(int n)    { (void) n; ice_arr_clear(&work); }
+static void run_rotate(int n)   { ice_arr_rotate(&work, n / 3 + 1); }
+static void run_move(int n)     { ice_arr_move(&work, 0, n / 2, n / 2, &sink); }
+
+// Reductions and searches
+static void run_sum(int n)          { (void) n; dsink = ice_arr_sum(a); }
+static void run_sum_kahan(int n)    { (void) n; dsink = ice_arr_sum_with_mode(a, ICE_ARR_SUM_KAHAN); }
+static void run_sum_pairwise(int n) { (void) n; dsink = ice_arr_sum_with_mode(a, ICE_ARR_SUM_PAIRWISE); }
+static void run_min(int n)          { (void) n; dsink = ice_arr_min(a); }
+static void run_max(int n)          { (void) n; dsink = ice_arr_max(a); }
+static void run_matches(int n)      { (void) n; isink = ice_arr_matches(a, -1); }
+static void run_includes(int n)     { (void) n; isink = ice_arr_includes(a, -1); }
+static void run_first_index(int n)  { (void) n; isink = ice_arr_first_index(a, -1); }
+static void run_last_index(int n)   { (void) n; isink = ice_arr_last_index(a, -1); }
+static void run_match(int n)        { (void) n; isink = ice_arr_match(a, b); }
+static void run_foreach(int n)      { (void) n; ice_arr_foreach(a, bench_iter); }
+static void run_foreach_ctx(int n)  { double s = 0; (void) n; ice_arr_foreach_ctx(a, bench_iter_ctx, &s); dsink = s; }
+static void run_foreach_chunk(int n){ double s = 0; (void) n; ice_arr_foreach_chunk(a, bench_chunk, &s); dsink = s; }
+
+// Copying functions
+static void run_first(int n)     { BENCH_RESULT(ice_arr_first(a, n)); }
+static void run_last(int n)      { BENCH_RESULT(ice_arr_last(a, n)); }
+static void run_concat(int n)    { (void) n; BENCH_RESULT(ice_arr_concat(a, b)); }
+static void run_sub(int n)       { BENCH_RESULT(ice_arr_sub(a, 0, n - 1)); }
+static void run_without(int n)   { (void) n; BENCH_RESULT(ice_arr_without(a, 0)); }
+static void run_clone(int n)     { (void) n; BENCH_RESULT(ice_arr_clone(a, 2)); }
+static void run_rest(int n)      { BENCH_RESULT(ice_arr_rest(a, n / 2)); }
+static void run_unshift(int n)   { (void) n; BENCH_RESULT(ice_arr_unshift(a, 1)); }
+static void run_range(int n)     { BENCH_RESULT(ice_arr_range(n)); }
+static void run_compact(int n)   { (void) n; BENCH_RESULT(ice_arr_compact(a)); }
+static void run_tail(int n)      { (void) n; BENCH_RESULT(ice_arr_tail(a)); }
+
+// In-place filters
+static int bench_keep_even(double n) { return ((long long) n % 2 == 0) ? 1 : 0; }
+static void run_remove_all(int n)      { (void) n; isink = ice_arr_remove_all(&work, 0); }
+static void run_compact_inplace(int n) { (void) n; isink = ice_arr_compact_inplace(&work); }
+static void run_filter_inplace(int n)  { (void) n; isink = ice_arr_filter_inplace(&work, bench_keep_even); }
+static void run_dedup(int n)           { (void) n; isink = ice_arr_dedup_inplace(&work); }
+static void run_dedup_sorted(int n)    { (void) n; isink = ice_arr_dedup_inplace_with_mode(&work, ICE_ARR_SET_SORTED); }
+
+// Element-wise arithmetic
+static double bench_half(double n) { return n * 0.5; }
+static void run_add(int n)           { (void) n; BENCH_RESULT(ice_arr_add(a, b)); }
+static void run_add_inplace(int n)   { (void) n; ice_arr_add_inplace(&work, b); }
+static void run_mul_inplace(int n)   { (void) n; ice_arr_mul_inplace(&work, b); }
+static void run_scale_inplace(int n) { (void) n; ice_arr_scale_inplace(&work, 0.5); }
+static void run_axpy_inplace(int n)  { (void) n; ice_arr_axpy_inplace(0.5, b, &work); }
+static void run_dot(int n)           { (void) n; dsink = ice_arr_dot(a, b); }
+static void run_map_inplace(int n)   { (void) n; ice_arr_map_inplace(&work, bench_half); }
+
+// Sorting
+static void run_sort(int n)       { (void) n; ice_arr_sort(&work); }
+static void run_sort_asc(int n)   { (void) n; ice_arr_sort_asc(&work); }
+static void run_sort_ex(int n)    { (void) n; ice_arr_sort_ex(&work, bench_desc); }
+static void run_sort_radix(int n) { (void) n; ice_arr_sort_with_mode(&work, ICE_ARR_SORT_RADIX); }
+
+// Set operations
+static void run_unique(int n)           { (void) n; BENCH_RESULT(ice_arr_unique(a)); }
+static void run_unique_sorted(int n)    { (void) n; BENCH_RESULT(ice_arr_unique_with_mode(a, ICE_ARR_SET_SORTED)); }
+static void run_diff(int n)             { (void) n; BENCH_RESULT(ice_arr_diff(a, b)); }
+static void run_except(int n)           { (void) n; BENCH_RESULT(ice_arr_except(a, b)); }
+static void run_except_sorted(int n)    { (void) n; BENCH_RESULT(ice_arr_except_with_mode(a, b, ICE_ARR_SET_SORTED)); }
+static void run_intersect(int n)        { (void) n; BENCH_RESULT(ice_arr_intersect(a, b)); }
+static void run_intersect_sorted(int n) { (void) n; BENCH_RESULT(ice_arr_intersect_with_mode(a, b, ICE_ARR_SET_SORTED)); }
+static void run_union(int n)            { (void) n; BENCH_RESULT(ice_arr_union(a, b)); }
+static void run_union_sorted(int n)     { (void) n; BENCH_RESULT(ice_arr_union_with_mode(a, b, ICE_ARR_SET_SORTED)); }
+
+// Sorted arrays, n lookups per call
+static void run_lower_bound(int n)       { int s = 0; for (int i = 0; i < n; i++) s += ice_arr_lower_bound(sorted, a.arr[i]); isink = s; }
+static void run_sorted_includes(int n)   { int s = 0; for (int i = 0; i < n; i++) s += ice_arr_sorted_includes(sorted, a.arr[i]); isink = s; }
+static void run_eytzinger_lower(int n)   { int s = 0; for (int i = 0; i < n; i++) s += ice_arr_eytzinger_lower_bound(eyt, a.arr[i]); isink = s; }
+static void run_eytzinger(int n)         { (void) n; BENCH_RESULT(ice_arr_eytzinger(sorted)); }
+static void run_sorted_intersect(int n)  { (void) n; BENCH_RESULT(ice_arr_sorted_intersect(sorted, sorted)); }
+static void run_sorted_union(int n)      { (void) n; BENCH_RESULT(ice_arr_sorted_union(sorted, sorted)); }
+
+// Views
+static void run_view_of(int n)      { ice_arr_view v = ice_arr_view_of(a); isink = ice_arr_view_len(ice_arr_view_sub(v, 0, n - 1)); }
+static void run_view_get(int n)     { ice_arr_view v = ice_arr_last_view(a, n); double s = 0; for (int i = 0; i < n; i++) s += ice_arr_view_get(v, i); dsink = s; }
+static void run_view_sum(int n)     { dsink = ice_arr_view_sum(ice_arr_sub_view(a, 0, n - 1)); }
+static void run_view_step_sum(int n){ (void) n; dsink = ice_arr_view_sum(ice_arr_view_step(ice_arr_view_of(a), 2)); }
+static void run_view_min(int n)     { dsink = ice_arr_view_min(ice_arr_first_view(a, n)); }
+static void run_view_max(int n)     { (void) n; dsink = ice_arr_view_max(ice_arr_tail_view(a)); }
+static void run_view_to_array(int n){ (void) n; BENCH_RESULT(ice_arr_view_to_array(ice_arr_view_of(a))); }
+
+// Rings
+static void run_ring_push_back(int n)  { ice_arr_ring r = ice_arr_ring_new(n); for (int i = 0; i < n; i++) ice_arr_ring_push_back(&r, i); ice_arr_ring_free(r); }
+static void run_ring_push_front(int n) { ice_arr_ring r = ice_arr_ring_new(n); for (int i = 0; i < n; i++) ice_arr_ring_push_front(&r, i); ice_arr_ring_free(r); }
+static void run_ring_overwrite(int n)  { for (int i = 0; i < n; i++) ice_arr_ring_push_overwrite(&ring, i); }
+static void run_ring_get(int n)        { double s = 0; for (int i = 0; i < n; i++) s += ice_arr_ring_get(ring, i); dsink = s; }
+static void run_ring_set(int n)        { for (int i = 0; i < n; i++) ice_arr_ring_set(&ring, i, i); }
+static void run_ring_pop_back(int n)   { double s = 0; for (int i = 0; i < n; i++) s += ice_arr_ring_pop_back(&ring); dsink = s; }
+static void run_ring_pop_front(int n)  { double s = 0; for (int i = 0; i < n; i++) s += ice_arr_ring_pop_front(&ring); dsink = s; isink = ice_arr_ring_len(ring); }
+static void run_ring_rotate(int n)     { ice_arr_ring_rotate(&ring, n / 3 + 1); }
+static void run_ring_to_array(int n)   { (void) n; BENCH_RESULT(ice_arr_ring_to_array(ring)); }
+
+// Small arrays vs regular arrays, n / 8 arrays of 8 elements per call
+static void run_small_push(int n) {
+    for (int i = 0; i < n; i += 8) {
+        ice_arr_small t = ice_arr_small_new();
+        for (int j = 0; j < 8; j++) ice_arr_small_push(&t, j);
+        dsink = ice_arr_small_get(&t, 7);
+        ice_arr_small_free(&t);
+    }
+}
+
+static void run_array_push8(int n) {
+    for (int i = 0; i < n; i += 8) {
+        ice_arr_array t = ice_arr_new(0);
+        for (int j = 0; j < 8; j++) ice_arr_push(&t, j);
+        dsink = ice_arr_get(t, 7);
+        ice_arr_free(t);
+    }
+}
+
+// Statistics
+static void run_stats_push(int n)   { ice_arr_stats st = ice_arr_stats_new(); for (int i = 0; i < n; i++) ice_arr_stats_push(&st, a.arr[i]); dsink = st.mean; }
+static void run_stats_of(int n)     { (void) n; dsink = ice_arr_stats_of(a).mean; }
+static void run_digest_push(int n)  { ice_arr_digest d = ice_arr_digest_new(100); ice_arr_digest_push_n(&d, a.arr, n); dsink = ice_arr_digest_quantile(&d, 0.99); ice_arr_digest_free(d); }
+
+// Binary files
+#define BENCH_FILE "ice_arr_bench.iarr"
+static void run_save(int n)      { (void) n; isink = ice_arr_save(a, BENCH_FILE); }
+static void run_load(int n)      { (void) n; BENCH_RESULT(ice_arr_load(BENCH_FILE)); }
+static void run_map_file(int n)  { (void) n; ice_arr_view v = ice_arr_map_file(BENCH_FILE); dsink = ice_arr_view_sum(v); ice_arr_unmap_file(v); }
+
+// Arenas, 64 short-lived copies per call
+static void run_arena(int n) {
+    (void) n;
+    ice_arr_arena* prev = ice_arr_arena_bind(&arena);
+    for (int i = 0; i < 64; i++) dsink = ice_arr_tail(a).len;
+    ice_arr_arena_bind(prev);
+    ice_arr_arena_reset(&arena);
+}
+
+static void run_heap_copies(int n) {
+    (void) n;
+    for (int i = 0; i < 64; i++) { ice_arr_array t = ice_arr_tail(a); dsink = t.len; ice_arr_free(t); }
+}
+
+// Typed arrays
+static void setup_typed(int n) {
+    for (int i = 0; i < n; i++) {
+        ice_arr_f32_set(&f32, i, (float) a.arr[i]);
+        ice_arr_i32_set(&i32, i, (int32_t) a.arr[i]);
+        ice_arr_i64_set(&i64, i, (int64_t) a.arr[i]);
+        ice_arr_u8_set(&u8, i, (uint8_t) a.arr[i]);
+    }
+}
+
+static void run_f32_sum(int n)  { (void) n; dsink = ice_arr_f32_sum(f32); }
+static void run_i32_sum(int n)  { (void) n; dsink = (double) ice_arr_i32_sum(i32); }
+static void run_i64_sum(int n)  { (void) n; dsink = (double) ice_arr_i64_sum(i64); }
+static void run_u8_sum(int n)   { (void) n; dsink = (double) ice_arr_u8_sum(u8); }
+static void run_f32_min(int n)  { (void) n; dsink = ice_arr_f32_min(f32); }
+static void run_i32_max(int n)  { (void) n; dsink = ice_arr_i32_max(i32); }
+static void run_u8_matches(int n) { (void) n; isink = ice_arr_u8_matches(u8, 255); }
+static void run_f32_sort(int n) { (void) n; ice_arr_f32_sort(&f32); }
+static void run_i32_sort(int n) { (void) n; ice_arr_i32_sort(&i32); }
+static void run_i64_sort(int n) { (void) n; ice_arr_i64_sort(&i64); }
+static void run_u8_sort(int n)  { (void) n; ice_arr_u8_sort(&u8); }
+
+static bench_case cases[BENCH_MAX_CASES] = {
+    { "ice_arr_new",                      NULL,            run_new, 0 },
+    { "ice_arr_get",                      NULL,            run_get, 0 },
+    { "ice_arr_set",                      setup_work,      run_set, 0 },
+    { "ice_arr_len",                      NULL,            run_len, 0 },
+    { "ice_arr_push",                     NULL,            run_push, 0 },
+    { "ice_arr_push_n",                   NULL,            run_push_n, 0 },
+    { "ice_arr_reserve",                  NULL,            run_reserve, 0 },
+    { "ice_arr_shrink_to_fit",            setup_work,      run_shrink, 0 },
+    { "ice_arr_pop",                      setup_work,      run_pop, 0 },
+    { "ice_arr_shift",                    setup_work,      run_shift, 0 },
+    { "ice_arr_rem",                      setup_work,      run_rem, 0 },
+    { "ice_arr_rev",                      setup_work,      run_rev, 0 },
+    { "ice_arr_fill",                     setup_work,      run_fill, 0 },
+    { "ice_arr_clear",                    setup_work,      run_clear, 0 },
+    { "ice_arr_rotate",                   setup_work,      run_rotate, 0 },
+    { "ice_arr_move",                     setup_work,      run_move, 0 },
+    { "ice_arr_sum",                      NULL,            run_sum, 0 },
+    { "ice_arr_sum_with_mode(KAHAN)",     NULL,            run_sum_kahan, 0 },
+    { "ice_arr_sum_with_mode(PAIRWISE)",  NULL,            run_sum_pairwise, 0 },
+    { "ice_arr_min",                      NULL,            run_min, 0 },
+    { "ice_arr_max",                      NULL,            run_max, 0 },
+    { "ice_arr_matches",                  NULL,            run_matches, 0 },
+    { "ice_arr_includes",                 NULL,            run_includes, 0 },
+    { "ice_arr_first_index",              NULL,            run_first_index, 0 },
+    { "ice_arr_last_index",               NULL,            run_last_index, 0 },
+    { "ice_arr_match",                    NULL,            run_match, 0 },
+    { "ice_arr_foreach",                  NULL,            run_foreach, 0 },
+    { "ice_arr_foreach_ctx",              NULL,            run_foreach_ctx, 0 },
+    { "ice_arr_foreach_chunk",            NULL,            run_foreach_chunk, 0 },
+    { "ice_arr_first",                    NULL,            run_first, 0 },
+    { "ice_arr_last",                     NULL,            run_last, 0 },
+    { "ice_arr_concat",                   NULL,            run_concat, 0 },
+    { "ice_arr_sub",                      NULL,            run_sub, 0 },
+    { "ice_arr_without",                  NULL,            run_without, 0 },
+    { "ice_arr_clone",                    NULL,            run_clone, 0 },
+    { "ice_arr_rest",                     NULL,            run_rest, 0 },
+    { "ice_arr_unshift",                  NULL,            run_unshift, 0 },
+    { "ice_arr_range",                    NULL,            run_range, 0 },
+    { "ice_arr_compact",                  NULL,            run_compact, 0 },
+    { "ice_arr_tail",                     NULL,            run_tail, 0 },
+    { "ice_arr_add",                      NULL,            run_add, 0 },
+    { "ice_arr_add_inplace",              setup_work,      run_add_inplace, 0 },
+    { "ice_arr_mul_inplace",              setup_work,      run_mul_inplace, 0 },
+    { "ice_arr_scale_inplace",            setup_work,      run_scale_inplace, 0 },
+    { "ice_arr_axpy_inplace",             setup_work,      run_axpy_inplace, 0 },
+    { "ice_arr_dot",                      NULL,            run_dot, 0 },
+    { "ice_arr_map_inplace",              setup_work,      run_map_inplace, 0 },
+    { "ice_arr_remove_all",               setup_work,      run_remove_all, 0 },
+    { "ice_arr_compact_inplace",          setup_work,      run_compact_inplace, 0 },
+    { "ice_arr_filter_inplace",           setup_work,      run_filter_inplace, 0 },
+    { "ice_arr_dedup_inplace",            setup_work,      run_dedup, 0 },
+    { "ice_arr_dedup_inplace_with_mode(SORTED)", setup_work, run_dedup_sorted, 0 },
+    { "ice_arr_sort",                     setup_work,      run_sort, 0 },
+    { "ice_arr_sort_asc",                 setup_work,      run_sort_asc, 0 },
+    { "ice_arr_sort_ex",                  setup_work,      run_sort_ex, 0 },
+    { "ice_arr_sort_with_mode(RADIX)",    setup_work,      run_sort_radix, 0 },
+    { "ice_arr_unique",                   NULL,            run_unique, 0 },
+    { "ice_arr_unique_with_mode(SORTED)", NULL,            run_unique_sorted, 0 },
+    { "ice_arr_diff",                     NULL,            run_diff, 0 },
+    { "ice_arr_except",                   NULL,            run_except, 0 },
+    { "ice_arr_except_with_mode(SORTED)", NULL,            run_except_sorted, 0 },
+    { "ice_arr_intersect",                NULL,            run_intersect, 0 },
+    { "ice_arr_intersect_with_mode(SORTED)", NULL,         run_intersect_sorted, 0 },
+    { "ice_arr_union",                    NULL,            run_union, 0 },
+    { "ice_arr_union_with_mode(SORTED)",  NULL,            run_union_sorted, 0 },
+    { "ice_arr_lower_bound(x n)",         NULL,            run_lower_bound, 0 },
+    { "ice_arr_sorted_includes(x n)",     NULL,            run_sorted_includes, 0 },
+    { "ice_arr_eytzinger_lower_bound(x n)", NULL,          run_eytzinger_lower, 0 },
+    { "ice_arr_eytzinger",                NULL,            run_eytzinger, 0 },
+    { "ice_arr_sorted_intersect",         NULL,            run_sorted_intersect, 0 },
+    { "ice_arr_sorted_union",             NULL,            run_sorted_union, 0 },
+    { "ice_arr_view_of+view_sub",         NULL,            run_view_of, 0 },
+    { "ice_arr_view_get",                 NULL,            run_view_get, 0 },
+    { "ice_arr_view_sum",                 NULL,            run_view_sum, 0 },
+    { "ice_arr_view_sum(step 2)",         NULL,            run_view_step_sum, 0 },
+    { "ice_arr_view_min",                 NULL,            run_view_min, 0 },
+    { "ice_arr_view_max",                 NULL,            run_view_max, 0 },
+    { "ice_arr_view_to_array",            NULL,            run_view_to_array, 0 },
+    { "ice_arr_ring_push_back",           NULL,            run_ring_push_back, 0 },
+    { "ice_arr_ring_push_front",          NULL,            run_ring_push_front, 0 },
+    { "ice_arr_ring_push_overwrite",      setup_ring,      run_ring_overwrite, 0 },
+    { "ice_arr_ring_get",                 setup_ring,      run_ring_get, 0 },
+    { "ice_arr_ring_set",                 setup_ring,      run_ring_set, 0 },
+    { "ice_arr_ring_pop_back",            setup_ring,      run_ring_pop_back, 0 },
+    { "ice_arr_ring_pop_front",           setup_ring,      run_ring_pop_front, 0 },
+    { "ice_arr_ring_rotate",              setup_ring,      run_ring_rotate, 0 },
+    { "ice_arr_ring_to_array",            setup_ring,      run_ring_to_array, 0 },
+    { "ice_arr_small_push(x8)",           NULL,            run_small_push, 0 },
+    { "ice_arr_push(x8)",                 NULL,            run_array_push8, 0 },
+    { "ice_arr_stats_push",               NULL,            run_stats_push, 0 },
+    { "ice_arr_stats_of",                 NULL,            run_stats_of, 0 },
+    { "ice_arr_digest_push_n+quantile",   NULL,            run_digest_push, 0 },
+    { "ice_arr_save",                     NULL,            run_save, 0 },
+    { "ice_arr_load",                     NULL,            run_load, 0 },
+    { "ice_arr_map_file+view_sum",        NULL,            run_map_file, 0 },
+    { "ice_arr_tail(arena x64)",          NULL,            run_arena, 0 },
+    { "ice_arr_tail(heap x64)",           setup_free_sink, run_heap_copies, 0 },
+    { "ice_arr_f32_sum",                  NULL,            run_f32_sum, 0 },
+    { "ice_arr_i32_sum",                  NULL,            run_i32_sum, 0 },
+    { "ice_arr_i64_sum",                  NULL,            run_i64_sum, 0 },
+    { "ice_arr_u8_sum",                   NULL,            run_u8_sum, 0 },
+    { "ice_arr_f32_min",                  NULL,            run_f32_min, 0 },
+    { "ice_arr_i32_max",                  NULL,            run_i32_max, 0 },
+    { "ice_arr_u8_matches",               NULL,            run_u8_matches, 0 },
+    { "ice_arr_f32_sort",                 setup_typed,     run_f32_sort, 0 },
+    { "ice_arr_i32_sort",                 setup_typed,     run_i32_sort, 0 },
+    { "ice_arr_i64_sort",                 setup_typed,     run_i64_sort, 0 },
+    { "ice_arr_u8_sort",                  setup_typed,     run_u8_sort, 0 },
+};
+
+static void bench_inputs(int n) {
+    a    = ice_arr_new(n);
+    b    = ice_arr_new(n);
+    work = ice_arr_new(n);
+    sink = (ice_arr_array) { NULL, 0, 0 };
+    ring = ice_arr_ring_new(n);
+
+    // Values repeat so set operations and searches see duplicates, b overlaps a by half
+    for (int i = 0; i < n; i++) {
+        a.arr[i] = bench_rand(n);
+        b.arr[i] = bench_rand(n) + (n / 2);
+    }
+
+    sorted = ice_arr_clone(a, 1);
+    ice_arr_sort_asc(&sorted);
+    eyt = ice_arr_eytzinger(sorted);
+
+    f32 = ice_arr_f32_new(n);
+    i32 = ice_arr_i32_new(n);
+    i64 = ice_arr_i64_new(n);
+    u8  = ice_arr_u8_new(n);
+    setup_typed(n);
+}
+
+static void bench_release(void) {
+    ice_arr_free(a);
+    ice_arr_free(b);
+    ice_arr_free(work);
+    ice_arr_free(sink);
+    ice_arr_free(sorted);
+    ice_arr_free(eyt);
+    ice_arr_ring_free(ring);
+    ice_arr_f32_free(f32);
+    ice_arr_i32_free(i32);
+    ice_arr_i64_free(i64);
+    ice_arr_u8_free(u8);
+}
+
+int main(int argc, char** argv) {
+    long long max_size = (argc > 1) ? atoll(argv[1]) : BENCH_MAX_SIZE;
+    if (max_size > BENCH_MAX_SIZE) max_size = BENCH_MAX_SIZE;
+
+    arena = ice_arr_arena_new(0);
+    printf("function,elements,iterations,ns_total,ns_per_element,allocations\n");
+
+    for (long long size = BENCH_MIN_SIZE; size <= max_size; size *= 4) {
+        int n = (int) size;
+        bench_inputs(n);
+
+        for (int c = 0; c < BENCH_MAX_CASES && cases[c].name != NULL; c++) {
+            bench_case* bc = &cases[c];
+            double total = 0;
+            long long iters = 0;
+            long long allocs = 0;
+
+            if (bc->skip) {
+                printf("%s,%d,0,skipped,skipped,0\n", bc->name, n);
+                continue;
+            }
+
+            double wall = bench_now();
+
+            while (total < BENCH_TARGET_NS && (bench_now() - wall) < BENCH_WALL_NS) {
+                if (bc->setup != NULL) bc->setup(n);
+
+                long long before = bench_allocs;
+                double start = bench_now();
+                bc->run(n);
+                double elapsed = bench_now() - start;
+
+                allocs += bench_allocs - before;
+                total += elapsed;
+                iters++;
+
+                if (elapsed > BENCH_BUDGET_NS) {
+                    bc->skip = 1;
+                    break;
+                }
+            }
+
+            printf("%s,%d,%lld,%.0f,%.3f,%lld\n", bc->name, n, iters, total,
+                   total / ((double) iters * n), allocs / iters);
+            fflush(stdout);
+        }
+
+        bench_release();
+    }
+
+    ice_arr_arena_free(&arena);
+    remove(BENCH_FILE);
+    return 0;
+}
@@ -0,0 +1,460 @@
+// Tests for ice_arr.h, Each test asserts so failing one aborts the run
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Largest zeroed allocation requested, So tests can check that nothing huge was allocated
+static size_t test_max_calloc = 0;
+
+static void* test_calloc(size_t count, size_t size) {
+    if (count * size > test_max_calloc) test_max_calloc = count * size;
+    return calloc(count, size);
+}
+
+#define ICE_ARR_CALLOC(count, size) test_calloc(count, size)
+
+#define ICE_ARR_IMPL
+#define ICE_TEST_IMPL
+#include "ice_arr.h"
+#include "ice_test.h"
+
+static ice_arr_array test_arr(double* vals, int len) {
+    ice_arr_array arr = ice_arr_new(len);
+    for (int i = 0; i < len; i++) arr.arr[i] = vals[i];
+    return arr;
+}
+
+// Same element for set functions: All NaNs are same and -0.0 is same as 0.0
+static int test_same(double a, double b) {
+    return (a != a) ? (b != b) : (a == b);
+}
+
+static int test_count(ice_arr_array arr, double val) {
+    int count = 0;
+    for (int i = 0; i < arr.len; i++) count += test_same(arr.arr[i], val);
+    return count;
+}
+
+// Returns 1 if a and b have same elements same number of times (Order is ignored)
+static int test_same_elements(ice_arr_array a, ice_arr_array b) {
+    if (a.len != b.len) return 0;
+
+    for (int i = 0; i < a.len; i++) {
+        if (test_count(a, a.arr[i]) != test_count(b, a.arr[i])) return 0;
+    }
+
+    return 1;
+}
+
+ICE_TEST_CREATE(set_modes_nan_and_zero) {
+    double pos_nan = NAN;
+    double neg_nan = -NAN;
+    double v1[] = { 1, neg_nan, 0.0, 3, pos_nan, -0.0, 1, 2 };
+    double v2[] = { pos_nan, 1, -0.0, 5, neg_nan, 0.0 };
+
+    ice_arr_array a1 = test_arr(v1, 8);
+    ice_arr_array a2 = test_arr(v2, 6);
+
+    for (int op = 0; op < 4; op++) {
+        ice_arr_array h1 = ice_arr_clone(a1, 1), h2 = ice_arr_clone(a2, 1);
+        ice_arr_array s1 = ice_arr_clone(a1, 1), s2 = ice_arr_clone(a2, 1);
+        ice_arr_array hash, sorted;
+
+        if (op == 0) {
+            hash = ice_arr_unique_with_mode(h1, ICE_ARR_SET_HASH);
+            sorted = ice_arr_unique_with_mode(s1, ICE_ARR_SET_SORTED);
+            ICE_TEST_ASSERT_TRUE(hash.len == 2 && test_count(hash, 3) == 1 && test_count(hash, 2) == 1);
+        } else if (op == 1) {
+            hash = ice_arr_except_with_mode(h1, h2, ICE_ARR_SET_HASH);
+            sorted = ice_arr_except_with_mode(s1, s2, ICE_ARR_SET_SORTED);
+            ICE_TEST_ASSERT_TRUE(test_count(hash, 3) == 1 && test_count(hash, 2) == 1 && test_count(hash, 1) == 0);
+        } else if (op == 2) {
+            hash = ice_arr_intersect_with_mode(h1, h2, ICE_ARR_SET_HASH);
+            sorted = ice_arr_intersect_with_mode(s1, s2, ICE_ARR_SET_SORTED);
+            ICE_TEST_ASSERT_TRUE(test_count(hash, 1) == 1 && test_count(hash, NAN) == 1 && test_count(hash, 0) == 1);
+        } else {
+            hash = ice_arr_union_with_mode(h1, h2, ICE_ARR_SET_HASH);
+            sorted = ice_arr_union_with_mode(s1, s2, ICE_ARR_SET_SORTED);
+            ICE_TEST_ASSERT_EQU(hash.len, 6);
+        }
+
+        ICE_TEST_ASSERT_TRUE(test_same_elements(hash, sorted));
+
+        ice_arr_free(hash);
+        ice_arr_free(sorted);
+        ice_arr_free(h1);
+        ice_arr_free(h2);
+        ice_arr_free(s1);
+        ice_arr_free(s2);
+    }
+
+    ice_arr_free(a1);
+    ice_arr_free(a2);
+    printf("TEST set_modes_nan_and_zero RAN SUCCESSFULLY!\n");
+}
+
+ICE_TEST_CREATE(arena_keeps_heap_arrays) {
+    ice_arr_array heap = ice_arr_new(0);
+    ice_arr_arena arena = ice_arr_arena_new(256);
+
+    ice_arr_arena_bind(&arena);
+
+    ice_arr_array tmp = ice_arr_new(0);
+
+    for (int i = 0; i < 100; i++) {
+        ice_arr_push(&heap, i);
+        ice_arr_push(&tmp, i);
+    }
+
+    ICE_TEST_ASSERT_TRUE(tmp.len == 100 && tmp.arr[99] == 99);
+
+    ice_arr_free(tmp);
+    ice_arr_arena_bind(NULL);
+    ice_arr_arena_reset(&arena);
+
+    // Heap array grown while arena was bound must survive reset and be freed by ice_arr_free
+    ICE_TEST_ASSERT_EQU(heap.len, 100);
+
+    for (int i = 0; i < heap.len; i++) {
+        ICE_TEST_ASSERT_EQU(heap.arr[i], i);
+    }
+
+    ice_arr_free(heap);
+    ice_arr_arena_free(&arena);
+    printf("TEST arena_keeps_heap_arrays RAN SUCCESSFULLY!\n");
+}
+
+// Returns 1 if arr holds exactly len elements of vals
+static int test_equ(ice_arr_array arr, double* vals, int len) {
+    if (arr.len != len) return 0;
+
+    for (int i = 0; i < len; i++) {
+        if (arr.arr[i] != vals[i]) return 0;
+    }
+
+    return 1;
+}
+
+ICE_TEST_CREATE(slicing) {
+    double v[] = { 10, 11, 12, 13, 14 };
+    ice_arr_array arr = test_arr(v, 5);
+    ice_arr_array empty = ice_arr_new(0);
+    ice_arr_array res;
+
+    res = ice_arr_sub(arr, 1, 3);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 11, 12, 13 }, 3));
+    ice_arr_free(res);
+
+    // sub clamps from and to, Returns empty array if from > to
+    res = ice_arr_sub(arr, -2, 9);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, v, 5));
+    ice_arr_free(res);
+
+    res = ice_arr_sub(arr, 3, 1);
+    ICE_TEST_ASSERT_EQU(res.len, 0);
+    ice_arr_free(res);
+
+    res = ice_arr_sub(empty, 0, 2);
+    ICE_TEST_ASSERT_EQU(res.len, 0);
+    ice_arr_free(res);
+
+    // first/last return at least 1 element but never more than array has
+    res = ice_arr_first(arr, 2);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 10, 11 }, 2));
+    ice_arr_free(res);
+
+    res = ice_arr_first(arr, 0);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 10 }, 1));
+    ice_arr_free(res);
+
+    res = ice_arr_first(arr, 9);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, v, 5));
+    ice_arr_free(res);
+
+    res = ice_arr_first(empty, 3);
+    ICE_TEST_ASSERT_EQU(res.len, 0);
+    ice_arr_free(res);
+
+    res = ice_arr_last(arr, 2);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 14, 13 }, 2));
+    ice_arr_free(res);
+
+    res = ice_arr_last(arr, 9);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 14, 13, 12, 11, 10 }, 5));
+    ice_arr_free(res);
+
+    res = ice_arr_rest(arr, 1);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 10, 12, 13, 14 }, 4));
+    ice_arr_free(res);
+
+    res = ice_arr_rest(empty, 0);
+    ICE_TEST_ASSERT_EQU(res.len, 0);
+    ice_arr_free(res);
+
+    res = ice_arr_tail(arr);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 11, 12, 13, 14 }, 4));
+    ice_arr_free(res);
+
+    res = ice_arr_tail(empty);
+    ICE_TEST_ASSERT_EQU(res.len, 0);
+    ice_arr_free(res);
+
+    res = ice_arr_range(4);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 0, 1, 2, 3 }, 4));
+    ice_arr_free(res);
+
+    // rem ignores indexes out of range
+    ice_arr_rem(&arr, 4);
+    ice_arr_rem(&arr, 0);
+    ice_arr_rem(&arr, -1);
+    ice_arr_rem(&arr, 7);
+    ICE_TEST_ASSERT_TRUE(test_equ(arr, (double[]) { 11, 12, 13 }, 3));
+
+    ice_arr_free(arr);
+    ice_arr_free(empty);
+    printf("TEST slicing RAN SUCCESSFULLY!\n");
+}
+
+ICE_TEST_CREATE(sort_and_diff_semantics) {
+    double v1[] = { 3, 1, 2, 5, 1, 4 };
+    double v2[] = { 1, 2, 2, 4, 6 };
+    ice_arr_array a1 = test_arr(v1, 6);
+    ice_arr_array a2 = test_arr(v2, 5);
+    ice_arr_array res;
+
+    // ice_arr_sort keeps sorting from bigger to smaller, ice_arr_sort_asc sorts from smaller to bigger
+    res = ice_arr_clone(a1, 1);
+    ice_arr_sort(&res);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 5, 4, 3, 2, 1, 1 }, 6));
+    ice_arr_sort_asc(&res);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 1, 1, 2, 3, 4, 5 }, 6));
+    ice_arr_free(res);
+
+    // ice_arr_diff keeps elements of a1 that exist exactly once in a2, ice_arr_except keeps ones not in a2
+    res = ice_arr_diff(a1, a2);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 1, 1, 4 }, 3));
+    ice_arr_free(res);
+
+    res = ice_arr_except(a1, a2);
+    ICE_TEST_ASSERT_TRUE(test_equ(res, (double[]) { 3, 5 }, 2));
+    ice_arr_free(res);
+
+    ice_arr_free(a1);
+    ice_arr_free(a2);
+    printf("TEST sort_and_diff_semantics RAN SUCCESSFULLY!\n");
+}
+
+ICE_TEST_CREATE(first_last_views) {
+    double v[] = { 10, 11, 12 };
+    ice_arr_array arr = test_arr(v, 3);
+    ice_arr_array empty = ice_arr_new(0);
+
+    // Views clamp elems same as ice_arr_first and ice_arr_last
+    for (int elems = -1; elems <= 4; elems++) {
+        ice_arr_array first = ice_arr_first(arr, elems);
+        ice_arr_array last = ice_arr_last(arr, elems);
+        ice_arr_view first_view = ice_arr_first_view(arr, elems);
+        ice_arr_view last_view = ice_arr_last_view(arr, elems);
+
+        ICE_TEST_ASSERT_TRUE(first_view.len == first.len && last_view.len == last.len);
+
+        for (int i = 0; i < first.len; i++) {
+            ICE_TEST_ASSERT_TRUE(first_view.arr[i * first_view.stride] == first.arr[i]);
+            ICE_TEST_ASSERT_TRUE(last_view.arr[i * last_view.stride] == last.arr[i]);
+        }
+
+        ice_arr_free(first);
+        ice_arr_free(last);
+    }
+
+    ICE_TEST_ASSERT_EQU(ice_arr_first_view(empty, 2).len, 0);
+    ICE_TEST_ASSERT_EQU(ice_arr_last_view(empty, 2).len, 0);
+
+    ice_arr_free(arr);
+    ice_arr_free(empty);
+    printf("TEST first_last_views RAN SUCCESSFULLY!\n");
+}
+
+ICE_TEST_CREATE(load_checks_file_size) {
+    const char* path = "ice_arr_test.bin";
+    double v[] = { 1.5, -2, 3 };
+    ice_arr_array arr = test_arr(v, 3);
+    unsigned char file[64];
+    size_t size;
+    FILE* f;
+
+    ICE_TEST_ASSERT_EQU(ice_arr_save(arr, path), ICE_ARR_TRUE);
+
+    ice_arr_array loaded = ice_arr_load(path);
+    ICE_TEST_ASSERT_TRUE(test_equ(loaded, v, 3));
+    ice_arr_free(loaded);
+
+    f = fopen(path, "rb");
+    size = fread(file, 1, sizeof(file), f);
+    fclose(f);
+
+    // Truncated payload
+    f = fopen(path, "wb");
+    fwrite(file, 1, size - 8, f);
+    fclose(f);
+    ICE_TEST_ASSERT_NULL(ice_arr_load(path).arr);
+
+    // Header only, Claiming 2^31 - 1 elements must be rejected without allocating them
+    file[12] = 0xFF; file[13] = 0xFF; file[14] = 0xFF; file[15] = 0x7F;
+    f = fopen(path, "wb");
+    fwrite(file, 1, size - 3 * sizeof(double), f);
+    fclose(f);
+    test_max_calloc = 0;
+    ICE_TEST_ASSERT_NULL(ice_arr_load(path).arr);
+    ICE_TEST_ASSERT_TRUE(test_max_calloc < 1024);
+
+    remove(path);
+    ice_arr_free(arr);
+    printf("TEST load_checks_file_size RAN SUCCESSFULLY!\n");
+}
+
+ICE_TEST_CREATE(move_grows_destination) {
+    double v1[] = { 1, 2, 3, 4 };
+    double v2[] = { 9, 8 };
+    ice_arr_array a1 = test_arr(v1, 4);
+    ice_arr_array a2 = test_arr(v2, 2);
+
+    // All elems_count elements are copied, a2 grows and a1 is unchanged
+    ice_arr_move(&a1, 1, 3, 1, &a2);
+    ICE_TEST_ASSERT_TRUE(test_equ(a2, (double[]) { 9, 2, 3, 4 }, 4));
+    ICE_TEST_ASSERT_TRUE(test_equ(a1, v1, 4));
+
+    // Copy inside a2 keeps len, Copy past end zero-fills the gap
+    ice_arr_move(&a2, 0, 2, 2, &a2);
+    ICE_TEST_ASSERT_TRUE(test_equ(a2, (double[]) { 9, 2, 9, 2 }, 4));
+
+    ice_arr_move(&a1, 2, 9, 6, &a2);
+    ICE_TEST_ASSERT_TRUE(test_equ(a2, (double[]) { 9, 2, 9, 2, 0, 0, 3, 4 }, 8));
+
+    ice_arr_free(a1);
+    ice_arr_free(a2);
+    printf("TEST move_grows_destination RAN SUCCESSFULLY!\n");
+}
+
+static int test_odd(int32_t n) {
+    return (n % 2) != 0;
+}
+
+ICE_TEST_CREATE(typed_arrays) {
+    const char* path = "ice_arr_test_typed.bin";
+    double v[] = { NAN, 1e300, -1e300, -1, 300, 2.75 };
+    ice_arr_array arr = test_arr(v, 6);
+
+    // Values out of range of element type are clamped, NaN becomes 0 in integer arrays
+    ice_arr_i32 i32 = ice_arr_i32_from_array(arr);
+    ice_arr_u8 u8 = ice_arr_u8_from_array(arr);
+    ice_arr_f32 f32 = ice_arr_f32_from_array(arr);
+    ICE_TEST_ASSERT_TRUE(i32.arr[0] == 0 && i32.arr[1] == INT32_MAX && i32.arr[2] == INT32_MIN && i32.arr[3] == -1 && i32.arr[5] == 2);
+    ICE_TEST_ASSERT_TRUE(u8.arr[0] == 0 && u8.arr[1] == 255 && u8.arr[2] == 0 && u8.arr[3] == 0 && u8.arr[4] == 255 && u8.arr[5] == 2);
+    ICE_TEST_ASSERT_TRUE(f32.arr[0] != f32.arr[0] && f32.arr[1] == HUGE_VALF && f32.arr[2] == -HUGE_VALF && f32.arr[5] == 2.75f);
+    ice_arr_i32_free(i32);
+    ice_arr_u8_free(u8);
+    ice_arr_f32_free(f32);
+
+    // Sums and element-wise math of integers wrap around instead of overflowing
+    ice_arr_i64 i64 = ice_arr_i64_new(9);
+    ice_arr_i64_fill(&i64, INT64_MAX);
+    ICE_TEST_ASSERT_EQU(ice_arr_i64_sum(i64), INT64_MAX - 8);
+    ice_arr_i64_free(i64);
+
+    u8 = ice_arr_u8_new(2);
+    u8.arr[0] = 200; u8.arr[1] = 100;
+    ice_arr_u8_add_inplace(&u8, (ice_arr_u8) { (uint8_t[]) { 100, 100 }, 2, 2 });
+    ICE_TEST_ASSERT_TRUE(u8.arr[0] == 44 && u8.arr[1] == 200);
+    ICE_TEST_ASSERT_EQU(ice_arr_u8_dot(u8, u8), 44 * 44 + 200 * 200);
+    ice_arr_u8_free(u8);
+
+    // Sort is descending like ice_arr_sort, Sorted API expects ascending order
+    i32 = ice_arr_i32_new(0);
+    int32_t vals[] = { 5, -3, 9, 5, 0, -3, 7, 2 };
+    ice_arr_i32_push_n(&i32, vals, 8);
+    ice_arr_i32_sort(&i32);
+    ICE_TEST_ASSERT_TRUE(i32.arr[0] == 9 && i32.arr[7] == -3);
+    ice_arr_i32_sort_asc(&i32);
+    ICE_TEST_ASSERT_TRUE(i32.arr[0] == -3 && i32.arr[1] == -3 && i32.arr[7] == 9);
+    ICE_TEST_ASSERT_TRUE(ice_arr_i32_lower_bound(i32, 5) == 4 && ice_arr_i32_upper_bound(i32, 5) == 6);
+    ICE_TEST_ASSERT_TRUE(ice_arr_i32_sorted_includes(i32, 7) == ICE_ARR_TRUE && ice_arr_i32_sorted_includes(i32, 6) == ICE_ARR_FALSE);
+
+    ice_arr_i32 other = ice_arr_i32_new(0);
+    ice_arr_i32_push_n(&other, (int32_t[]) { -3, 1, 5, 5, 10 }, 5);
+
+    ice_arr_i32 res = ice_arr_i32_sorted_intersect(i32, other);
+    ICE_TEST_ASSERT_TRUE(res.len == 2 && res.arr[0] == -3 && res.arr[1] == 5);
+    ice_arr_i32_free(res);
+
+    res = ice_arr_i32_sorted_union(i32, other);
+    ICE_TEST_ASSERT_TRUE(res.len == 8 && res.arr[0] == -3 && res.arr[1] == 0 && res.arr[2] == 1 && res.arr[7] == 10);
+    ice_arr_i32_free(res);
+
+    // Set operations have same semantics as ice_arr_unique, ice_arr_diff, ice_arr_except, ice_arr_intersect and ice_arr_union
+    res = ice_arr_i32_unique(i32);
+    ICE_TEST_ASSERT_TRUE(res.len == 4 && res.arr[0] == 0 && res.arr[3] == 9);
+    ice_arr_i32_free(res);
+
+    res = ice_arr_i32_diff(i32, other);
+    ICE_TEST_ASSERT_TRUE(res.len == 2 && res.arr[0] == -3 && res.arr[1] == -3);
+    ice_arr_i32_free(res);
+
+    res = ice_arr_i32_except(i32, other);
+    ICE_TEST_ASSERT_TRUE(res.len == 4 && res.arr[0] == 0 && res.arr[1] == 2 && res.arr[2] == 7 && res.arr[3] == 9);
+    ice_arr_i32_free(res);
+
+    res = ice_arr_i32_intersect(i32, other);
+    ICE_TEST_ASSERT_TRUE(res.len == 2 && res.arr[0] == -3 && res.arr[1] == 5);
+    ice_arr_i32_free(res);
+
+    res = ice_arr_i32_union(i32, other);
+    ICE_TEST_ASSERT_EQU(res.len, 8);
+    ice_arr_i32_free(res);
+
+    // Views
+    ice_arr_i32_view view = ice_arr_i32_view_step(ice_arr_i32_tail_view(i32), 2);
+    ICE_TEST_ASSERT_TRUE(view.len == 4 && ice_arr_i32_view_get(view, 1) == 2 && ice_arr_i32_view_get(view, 4) == 0);
+    ICE_TEST_ASSERT_TRUE(ice_arr_i32_view_sum(view) == -3 + 2 + 5 + 9 && ice_arr_i32_view_min(view) == -3 && ice_arr_i32_view_max(view) == 9);
+    view = ice_arr_i32_last_view(i32, 3);
+    ICE_TEST_ASSERT_TRUE(view.len == 3 && ice_arr_i32_view_get(view, 0) == 9 && ice_arr_i32_view_get(view, 2) == 5);
+    res = ice_arr_i32_view_to_array(ice_arr_i32_first_view(i32, 2));
+    ICE_TEST_ASSERT_TRUE(res.len == 2 && res.arr[0] == -3 && res.arr[1] == -3);
+    ice_arr_i32_free(res);
+
+    // Stats and filters
+    ice_arr_stats stats = ice_arr_i32_stats_of(i32);
+    ICE_TEST_ASSERT_TRUE(stats.count == 8 && stats.min == -3 && stats.max == 9);
+
+    ICE_TEST_ASSERT_EQU(ice_arr_i32_dedup_inplace(&i32), 2);
+    ICE_TEST_ASSERT_EQU(ice_arr_i32_compact_inplace(&i32), 1);
+    ICE_TEST_ASSERT_EQU(ice_arr_i32_filter_inplace(&i32, test_odd), 1);
+    ICE_TEST_ASSERT_TRUE(i32.len == 4 && i32.arr[0] == -3 && i32.arr[1] == 5 && i32.arr[3] == 9);
+
+    // Save and load keep element type, Loading as other type fails
+    ICE_TEST_ASSERT_EQU(ice_arr_i32_save(i32, path), ICE_ARR_TRUE);
+    res = ice_arr_i32_load(path);
+    ICE_TEST_ASSERT_TRUE(res.len == 4 && memcmp(res.arr, i32.arr, 4 * sizeof(int32_t)) == 0);
+    ICE_TEST_ASSERT_NULL(ice_arr_f32_load(path).arr);
+    ICE_TEST_ASSERT_NULL(ice_arr_load(path).arr);
+    ice_arr_i32_free(res);
+    remove(path);
+
+    ice_arr_i32_free(i32);
+    ice_arr_i32_free(other);
+    ice_arr_free(arr);
+    printf("TEST typed_arrays RAN SUCCESSFULLY!\n");
+}
+
+int main(int argc, char** argv) {
+    slicing();
+    set_modes_nan_and_zero();
+    sort_and_diff_semantics();
+    arena_keeps_heap_arrays();
+    first_last_views();
+    load_checks_file_size();
+    move_grows_destination();
+    typed_arrays();
+    return 0;
+}
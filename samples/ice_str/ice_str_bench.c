@@ -0,0 +1,343 @@
+// Benchmark for ice_str.h functions over input sizes from 16 bytes to 16 MB
+// Prints CSV to stdout: function,bytes,iterations,ns_total,ns_per_byte,allocations
+// bytes is input string length, ns_per_byte is ns_total / (iterations * bytes)
+// and allocations is average count of allocator calls made by one iteration
+// Usage: ice_str_bench [max_bytes]
+// Monotonic clock: QueryPerformanceCounter on Windows, clock_gettime elsewhere (Needs POSIX declarations when built with -std=c99)
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+static long long bench_allocs = 0;
+
+static void* bench_malloc(size_t size)               { bench_allocs++; return malloc(size); }
+static void* bench_realloc(void* ptr, size_t size)   { bench_allocs++; return realloc(ptr, size); }
+
+#define ICE_STR_MALLOC(size)        bench_malloc(size)
+#define ICE_STR_REALLOC(ptr, size)  bench_realloc(ptr, size)
+#define ICE_STR_FREE(ptr)           free(ptr)
+
+#define ICE_STR_IMPL
+#include "ice_str.h"
+
+#define BENCH_MIN_SIZE      16
+#define BENCH_MAX_SIZE      (16 * 1024 * 1024)
+#define BENCH_TARGET_NS     20000000.0      // Repeat each case until ~20ms has been measured
+#define BENCH_WALL_NS       100000000.0     // ...or until 100ms passed including untimed setup
+#define BENCH_BUDGET_NS     2000000000.0    // Skip larger sizes once one call takes longer than 2s
+#define BENCH_MAX_CASES     128
+
+typedef void (*bench_func)(int n);
+
+typedef struct bench_case {
+    const char* name;
+    bench_func setup;   // Called before every timed call, not measured (may be NULL)
+    bench_func run;     // Measured call
+    int skip;           // Set once a call exceeded BENCH_BUDGET_NS
+} bench_case;
+
+// Shared inputs, rebuilt for every size
+// text is log-like lines of lowercase words, "ERROR" appears about once per 4 KB
+static char* text;
+static char* text_copy;
+static char* text_upper;
+static char* text_utf8;
+static char* work;
+static ice_str_buf text_buf, text_buf_copy, needle_buf, warning_buf;
+static ice_str_searcher searcher;
+static char* sink;
+static volatile int isink;
+
+static double bench_now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER now, freq;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&freq);
+    return (double) now.QuadPart * 1e9 / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#endif
+}
+
+static unsigned int bench_seed = 12345;
+
+static unsigned int bench_rand(unsigned int range) {
+    bench_seed = bench_seed * 1103515245u + 12345u;
+    return (bench_seed >> 8) % range;
+}
+
+#define BENCH_RESULT(expr) do { ICE_STR_FREE(sink); sink = (expr); } while (0)
+
+// Searching, "needle" never occurs so whole input is scanned
+static void run_strstr(int n)          { (void) n; isink = (strstr(text, "needle") != NULL); }
+static void run_find(int n)            { (void) n; isink = ice_str_find(text, "needle"); }
+static void run_rfind(int n)           { (void) n; isink = ice_str_rfind(text, "needle"); }
+static void run_count(int n)           { (void) n; isink = ice_str_count(text, "ERROR"); }
+static void run_searcher_count(int n)  { isink = ice_str_searcher_count(&searcher, text, n); }
+static void run_replace(int n)         { (void) n; BENCH_RESULT(ice_str_replace(text, "ERROR", "warning")); }
+
+// String buffers
+static void run_match(int n)           { (void) n; isink = ice_str_match(text, text_copy); }
+static void run_buf_match(int n)       { (void) n; isink = ice_str_buf_match(text_buf, text_buf_copy); }
+static void run_buf_find(int n)        { (void) n; isink = ice_str_buf_find(text_buf, needle_buf); }
+static void run_buf_replace(int n)     { (void) n; ice_str_buf r = ice_str_buf_replace(text_buf, needle_buf, warning_buf); ice_str_buf_free(&r); }
+static void run_buf_append(int n) {
+    ice_str_buf b = ice_str_buf_new(0);
+    for (int i = 0; i < n; i += 16) ice_str_buf_append(&b, text + i, (n - i < 16) ? n - i : 16);
+    ice_str_buf_free(&b);
+}
+
+// Case conversion and comparison (text_upper is uppercased copy of text)
+static void setup_work(int n)          { memcpy(work, text, n + 1); }
+static void run_upper(int n)           { (void) n; BENCH_RESULT(ice_str_upper(text)); }
+static void run_lower_inplace(int n)   { (void) n; ice_str_lower_inplace(work); }
+static void run_match_nocase(int n)    { (void) n; isink = ice_str_match_nocase(text, text_upper); }
+static void run_compare_nocase(int n)  { (void) n; isink = ice_str_compare_nocase(text, text_upper); }
+
+// UTF-8, text is ASCII only and text_utf8 has 2, 3 and 4 byte codepoints every few words
+static void run_utf8_valid(int n)      { (void) n; isink = ice_str_utf8_valid(text); }
+static void run_utf8_valid_mixed(int n) { (void) n; isink = ice_str_utf8_valid(text_utf8); }
+static void run_utf8_len(int n)        { (void) n; isink = ice_str_utf8_len(text_utf8); }
+static void run_utf8_sub(int n)        { (void) n; BENCH_RESULT(ice_str_utf8_sub(text_utf8, n / 4, n / 4 + 16)); }
+static void run_rev(int n)             { (void) n; BENCH_RESULT(ice_str_rev(text)); }
+static void run_utf8_rev(int n)        { (void) n; BENCH_RESULT(ice_str_utf8_rev(text)); }
+static void run_utf8_rev_mixed(int n)  { (void) n; BENCH_RESULT(ice_str_utf8_rev(text_utf8)); }
+
+// Splitting
+static void run_split(int n)           { (void) n; char** r = ice_str_splitlines(text); ice_str_arr_free(r); }
+static void run_tokenizer(int n) {
+    ice_str_tokenizer tok = ice_str_tokenizer_new(text, n, '\n');
+    ice_str_view token;
+    int count = 0;
+    while (ice_str_tokenizer_next(&tok, &token) == ICE_STR_TRUE) count++;
+    isink = count;
+}
+static void run_tokenizer_set(int n) {
+    ice_str_tokenizer tok = ice_str_tokenizer_new_set(text, n, " \n");
+    ice_str_view token;
+    int count = 0;
+    while (ice_str_tokenizer_next(&tok, &token) == ICE_STR_TRUE) count++;
+    isink = count;
+}
+
+// Building strings from 16 byte pieces (Concat chain is quadratic so it stops after 4096 pieces)
+static void run_concat(int n) {
+    char piece[17];
+    char* res = ice_str_concat("", "");
+    piece[16] = '\0';
+    for (int i = 0; i < n && i < 4096 * 16; i += 16) {
+        memcpy(piece, text + i, 16);
+        char* next = ice_str_concat(res, piece);
+        ICE_STR_FREE(res);
+        res = next;
+    }
+    ICE_STR_FREE(res);
+}
+static void run_builder(int n) {
+    ice_str_builder b = ice_str_builder_new(0);
+    for (int i = 0; i < n; i += 16) ice_str_builder_append_n(&b, text + i, 16);
+    BENCH_RESULT(ice_str_builder_finish(&b));
+}
+static void run_builder_int(int n) {
+    ice_str_builder b = ice_str_builder_new(0);
+    for (int i = 0; i < n; i += 8) { ice_str_builder_append_int(&b, i * 37); ice_str_builder_append_char(&b, ','); }
+    BENCH_RESULT(ice_str_builder_finish(&b));
+}
+static void run_builder_fmt(int n) {
+    ice_str_builder b = ice_str_builder_new(0);
+    for (int i = 0; i < n; i += 16) ice_str_builder_append_fmt(&b, "k%d=%d;", i & 255, i);
+    BENCH_RESULT(ice_str_builder_finish(&b));
+}
+
+// Same calls with arena bound, Everything is released by one reset instead of per-string frees
+static ice_str_arena arena;
+static void run_split_arena(int n) {
+    (void) n;
+    ice_str_arena_bind(&arena);
+    char** r = ice_str_splitlines(text);
+    ice_str_arr_free(r);
+    ice_str_arena_bind(NULL);
+    ice_str_arena_reset(&arena);
+}
+static void run_builder_int_arena(int n) {
+    ice_str_arena_bind(&arena);
+    ice_str_builder b = ice_str_builder_new(0);
+    for (int i = 0; i < n; i += 8) { ice_str_builder_append_int(&b, i * 37); ice_str_builder_append_char(&b, ','); }
+    isink = ice_str_len(ice_str_builder_finish(&b));
+    ice_str_arena_bind(NULL);
+    ice_str_arena_reset(&arena);
+}
+
+// Interning, Every word of text is interned into new pool
+static void run_intern(int n) {
+    ice_str_intern_pool pool = ice_str_intern_pool_new(0);
+    ice_str_tokenizer tok = ice_str_tokenizer_new_set(text, n, " \n");
+    ice_str_view token;
+    while (ice_str_tokenizer_next(&tok, &token) == ICE_STR_TRUE) ice_str_intern_n(&pool, token.str, token.len);
+    isink = pool.count;
+    ice_str_intern_pool_free(&pool);
+}
+
+static bench_case cases[BENCH_MAX_CASES] = {
+    { "strstr",                  NULL, run_strstr, 0 },
+    { "ice_str_find",            NULL, run_find, 0 },
+    { "ice_str_rfind",           NULL, run_rfind, 0 },
+    { "ice_str_count",           NULL, run_count, 0 },
+    { "ice_str_searcher_count",  NULL, run_searcher_count, 0 },
+    { "ice_str_replace",         NULL, run_replace, 0 },
+    { "ice_str_match",           NULL, run_match, 0 },
+    { "ice_str_buf_match",       NULL, run_buf_match, 0 },
+    { "ice_str_buf_find",        NULL, run_buf_find, 0 },
+    { "ice_str_buf_replace",     NULL, run_buf_replace, 0 },
+    { "ice_str_buf_append(x16)", NULL, run_buf_append, 0 },
+    { "ice_str_upper",           NULL, run_upper, 0 },
+    { "ice_str_lower_inplace",   setup_work, run_lower_inplace, 0 },
+    { "ice_str_match_nocase",    NULL, run_match_nocase, 0 },
+    { "ice_str_compare_nocase",  NULL, run_compare_nocase, 0 },
+    { "ice_str_utf8_valid",      NULL, run_utf8_valid, 0 },
+    { "ice_str_utf8_valid(mixed)", NULL, run_utf8_valid_mixed, 0 },
+    { "ice_str_utf8_len(mixed)", NULL, run_utf8_len, 0 },
+    { "ice_str_utf8_sub(mixed)", NULL, run_utf8_sub, 0 },
+    { "ice_str_rev",             NULL, run_rev, 0 },
+    { "ice_str_utf8_rev",        NULL, run_utf8_rev, 0 },
+    { "ice_str_utf8_rev(mixed)", NULL, run_utf8_rev_mixed, 0 },
+    { "ice_str_splitlines",      NULL, run_split, 0 },
+    { "ice_str_tokenizer",       NULL, run_tokenizer, 0 },
+    { "ice_str_tokenizer_set",   NULL, run_tokenizer_set, 0 },
+    { "ice_str_concat(x16)",     NULL, run_concat, 0 },
+    { "ice_str_builder(x16)",    NULL, run_builder, 0 },
+    { "ice_str_builder_int",     NULL, run_builder_int, 0 },
+    { "ice_str_builder_fmt",     NULL, run_builder_fmt, 0 },
+    { "ice_str_splitlines(arena)",  NULL, run_split_arena, 0 },
+    { "ice_str_builder_int(arena)", NULL, run_builder_int_arena, 0 },
+    { "ice_str_intern_n(words)", NULL, run_intern, 0 },
+    { NULL, NULL, NULL, 0 }
+};
+
+static void bench_inputs(int n) {
+    static const char* words[] = { "info", "request", "served", "in", "ms", "user", "cache", "miss", "hit", "db" };
+
+    text = (char*) malloc(n + 1);
+    int i = 0;
+
+    while (i < n) {
+        const char* w = (bench_rand(800) == 0) ? "ERROR" : words[bench_rand(10)];
+        int wl = (int) strlen(w);
+
+        for (int j = 0; j < wl && i < n; j++) text[i++] = w[j];
+        if (i < n) text[i++] = (bench_rand(12) == 0) ? '\n' : ' ';
+    }
+
+    text[n] = '\0';
+
+    // Same words with non-ASCII ones mixed in, Cut at codepoint boundary so it stays valid UTF-8
+    static const char* utf8_words[] = { "caf\xc3\xa9", "\xd0\xbc\xd0\xb8\xd1\x80", "\xe2\x82\xac", "\xf0\x9f\x98\x80" };
+    text_utf8 = (char*) malloc(n + 1);
+    i = 0;
+
+    while (i < n) {
+        const char* w = (bench_rand(6) == 0) ? utf8_words[bench_rand(4)] : words[bench_rand(10)];
+        int wl = (int) strlen(w);
+
+        if (i + wl + 1 > n) break;
+        memcpy(text_utf8 + i, w, wl);
+        i += wl;
+        text_utf8[i++] = ' ';
+    }
+
+    memset(text_utf8 + i, ' ', n - i);
+    text_utf8[n] = '\0';
+    searcher = ice_str_searcher_new("ERROR");
+
+    text_copy = (char*) malloc(n + 1);
+    memcpy(text_copy, text, n + 1);
+    text_upper = ice_str_upper(text);
+    work = (char*) malloc(n + 1);
+    text_buf = ice_str_buf_from_n(text, n);
+    text_buf_copy = ice_str_buf_from_n(text, n);
+    needle_buf = ice_str_buf_from("needle");
+    warning_buf = ice_str_buf_from("warning");
+}
+
+static void bench_release(void) {
+    free(text);
+    free(text_copy);
+    free(text_utf8);
+    free(work);
+    ICE_STR_FREE(text_upper);
+    ice_str_searcher_free(&searcher);
+    ice_str_buf_free(&text_buf);
+    ice_str_buf_free(&text_buf_copy);
+    ice_str_buf_free(&needle_buf);
+    ice_str_buf_free(&warning_buf);
+    ICE_STR_FREE(sink);
+    sink = NULL;
+}
+
+int main(int argc, char** argv) {
+    long long max_size = (argc > 1) ? atoll(argv[1]) : BENCH_MAX_SIZE;
+    if (max_size > BENCH_MAX_SIZE) max_size = BENCH_MAX_SIZE;
+
+    arena = ice_str_arena_new(0);
+    printf("function,bytes,iterations,ns_total,ns_per_byte,allocations\n");
+
+    for (long long size = BENCH_MIN_SIZE; size <= max_size; size *= 4) {
+        int n = (int) size;
+        bench_inputs(n);
+
+        for (int c = 0; c < BENCH_MAX_CASES && cases[c].name != NULL; c++) {
+            bench_case* bc = &cases[c];
+            double total = 0;
+            long long iters = 0;
+            long long allocs = 0;
+
+            if (bc->skip) {
+                printf("%s,%d,0,skipped,skipped,0\n", bc->name, n);
+                continue;
+            }
+
+            double wall = bench_now();
+
+            while (total < BENCH_TARGET_NS && (bench_now() - wall) < BENCH_WALL_NS) {
+                if (bc->setup != NULL) bc->setup(n);
+
+                long long before = bench_allocs;
+                double start = bench_now();
+                bc->run(n);
+                double elapsed = bench_now() - start;
+
+                allocs += bench_allocs - before;
+                total += elapsed;
+                iters++;
+
+                if (elapsed > BENCH_BUDGET_NS) {
+                    bc->skip = 1;
+                    break;
+                }
+            }
+
+            printf("%s,%d,%lld,%.0f,%.3f,%lld\n", bc->name, n, iters, total,
+                   total / ((double) iters * n), allocs / iters);
+            fflush(stdout);
+        }
+
+        bench_release();
+    }
+
+    ice_str_arena_free(&arena);
+    return 0;
+}
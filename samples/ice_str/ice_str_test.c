@@ -0,0 +1,205 @@
+// Tests for ice_str.h, Each test asserts so failing one aborts the run
+#define ICE_STR_IMPL
+#define ICE_TEST_IMPL
+#include <stdio.h>
+#include <string.h>
+#include "ice_str.h"
+#include "ice_test.h"
+
+ICE_TEST_CREATE(arena_keeps_heap_buffers) {
+    ice_str_buf heap = ice_str_buf_from("heap");
+    ice_str_arena arena = ice_str_arena_new(256);
+
+    ice_str_arena_bind(&arena);
+
+    ice_str_builder tmp = ice_str_builder_new(0);
+
+    for (int i = 0; i < 100; i++) {
+        ice_str_buf_append(&heap, "0123456789", 10);
+        ice_str_builder_append_int(&tmp, i);
+    }
+
+    ice_str_builder_free(&tmp);
+    ice_str_arena_bind(NULL);
+    ice_str_arena_reset(&arena);
+
+    // Heap buffer grown while arena was bound must survive reset and be freed by ice_str_buf_free
+    ICE_TEST_ASSERT_EQU(heap.len, 1004);
+    ICE_TEST_ASSERT_TRUE(memcmp(heap.str, "heap0123456789", 14) == 0 && heap.str[heap.len] == '\0');
+
+    ice_str_buf_free(&heap);
+    ice_str_arena_free(&arena);
+    printf("TEST arena_keeps_heap_buffers RAN SUCCESSFULLY!\n");
+}
+
+// Reference search functions, Byte by byte so they don't share code paths with ice_str.h
+static int test_find(char* str, char* sub) {
+    char* p = strstr(str, sub);
+    return (p == NULL) ? -1 : (int) (p - str);
+}
+
+static int test_rfind(char* str, char* sub) {
+    int len = (int) strlen(str), sublen = (int) strlen(sub);
+
+    for (int i = len - sublen; i >= 0; i--) {
+        if (memcmp(str + i, sub, sublen) == 0) return i;
+    }
+
+    return -1;
+}
+
+static int test_count(char* str, char* sub) {
+    int count = 0, sublen = (int) strlen(sub);
+
+    for (char* p = strstr(str, sub); p != NULL; p = strstr(p + sublen, sub)) count++;
+    return count;
+}
+
+// Pseudo-random text of 'a' and 'b' (Needles of these chars match often, Including across 32-byte blocks)
+static void test_text(char* str, int len, unsigned int seed) {
+    for (int i = 0; i < len; i++) {
+        seed = seed * 1103515245u + 12345u;
+        str[i] = ((seed >> 16) & 3) ? 'a' : 'b';
+    }
+
+    str[len] = '\0';
+}
+
+ICE_TEST_CREATE(search_across_blocks) {
+    char text[301];
+    char* needles[] = { "b", "ab", "bab", "abba", "aaaaaa", "babab", "c", "abababababababababababababababababab" };
+
+    for (unsigned int seed = 1; seed <= 8; seed++) {
+        test_text(text, 300, seed);
+
+        for (int n = 0; n < 8; n++) {
+            ICE_TEST_ASSERT_EQU(ice_str_find(text, needles[n]), test_find(text, needles[n]));
+            ICE_TEST_ASSERT_EQU(ice_str_rfind(text, needles[n]), test_rfind(text, needles[n]));
+            ICE_TEST_ASSERT_EQU(ice_str_count(text, needles[n]), test_count(text, needles[n]));
+        }
+    }
+
+    // Needle right before, across and after 32-byte block boundaries, Only occurrence in string
+    for (int pos = 0; pos <= 100 - 6; pos++) {
+        memset(text, 'x', 100);
+        text[100] = '\0';
+        memcpy(text + pos, "needle", 6);
+
+        ICE_TEST_ASSERT_EQU(ice_str_find(text, "needle"), pos);
+        ICE_TEST_ASSERT_EQU(ice_str_rfind(text, "needle"), pos);
+        ICE_TEST_ASSERT_EQU(ice_str_count(text, "needle"), 1);
+    }
+
+    // Overlapping matches are counted and replaced left to right without overlap
+    memset(text, 'a', 99);
+    text[99] = '\0';
+    ICE_TEST_ASSERT_EQU(ice_str_count(text, "aa"), 49);
+    ICE_TEST_ASSERT_EQU(ice_str_rfind(text, "aa"), 97);
+
+    char* res = ice_str_replace(text, "aa", "b");
+    ICE_TEST_ASSERT_TRUE(strlen(res) == 50 && res[48] == 'b' && res[49] == 'a' && ice_str_count(res, "a") == 1);
+    ice_str_free(res);
+
+    test_text(text, 300, 3);
+    res = ice_str_replace(text, "ab", "<>");
+    ICE_TEST_ASSERT_TRUE(strlen(res) == 300 && ice_str_count(res, "ab") == 0 && ice_str_count(res, "<>") == test_count(text, "ab"));
+    ice_str_free(res);
+
+    printf("TEST search_across_blocks RAN SUCCESSFULLY!\n");
+}
+
+// Checks that tokenizer returns same spans as splitting str by hand at every char of delims
+static int test_tokens(ice_str_tokenizer tok, char* str, int len, char* delims) {
+    ice_str_view token;
+    int start = 0;
+
+    for (int i = 0; i <= len; i++) {
+        if (i < len && strchr(delims, str[i]) == NULL) continue;
+        if (i == len && start == len) break;
+
+        if (ice_str_tokenizer_next(&tok, &token) == ICE_STR_FALSE) return 0;
+        if (token.str != str + start || token.len != i - start) return 0;
+        start = i + 1;
+    }
+
+    return ice_str_tokenizer_next(&tok, &token) == ICE_STR_FALSE;
+}
+
+ICE_TEST_CREATE(tokenizer_spans) {
+    char text[201];
+    char* many = "!#$%&()*+-./:;<=>?@[]^_";
+
+    for (int i = 0; i < 200; i++) text[i] = 'a' + (i % 26);
+    text[200] = '\0';
+
+    // Delimiters at start, In 32-byte blocks, Next to each other, On block boundaries and at end
+    int commas[] = { 0, 5, 31, 32, 33, 64, 65, 100, 127, 128, 199 };
+    for (int i = 0; i < 11; i++) text[commas[i]] = ',';
+    text[40] = ';';
+    text[150] = '#';
+
+    ICE_TEST_ASSERT_TRUE(test_tokens(ice_str_tokenizer_new(text, 200, ','), text, 200, ","));
+    ICE_TEST_ASSERT_TRUE(test_tokens(ice_str_tokenizer_new_set(text, 200, ",;"), text, 200, ",;"));
+
+    // More than 16 delimiters doesn't fit SIMD compare, So bitset is used
+    ICE_TEST_ASSERT_TRUE(test_tokens(ice_str_tokenizer_new_set(text, 200, many), text, 200, many));
+
+    // Only first len chars are split
+    ICE_TEST_ASSERT_TRUE(test_tokens(ice_str_tokenizer_new(text, 70, ','), text, 70, ","));
+
+    printf("TEST tokenizer_spans RAN SUCCESSFULLY!\n");
+}
+
+ICE_TEST_CREATE(utf8_across_blocks) {
+    // 2, 3 and 4 bytes codepoints between ASCII runs, Some of them crossing 16 and 32 bytes boundaries
+    char* parts[] = { "0123456789abcdefghijklmnopqrstu", "\xC3\xA9", "0123456789abcdefghijklmnopqrs", "\xE6\x97\xA5", "\xF0\x9F\x98\x80",
+                      "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz", "\xE6\x9C\xAC", "end" };
+    char text[256] = "";
+    char expected[256] = "";
+    int codepoints = 0;
+
+    for (int i = 0; i < 8; i++) {
+        strcat(text, parts[i]);
+        codepoints += (parts[i][0] & 0x80) ? 1 : (int) strlen(parts[i]);
+    }
+
+    ICE_TEST_ASSERT_EQU(ice_str_utf8_len(text), codepoints);
+
+    // Codepoint 31 is 2-byte one after first ASCII run, 61 and 62 are 3 and 4 bytes ones after second run
+    char* res = ice_str_utf8_sub(text, 30, 33);
+    ICE_TEST_ASSERT_TRUE(strcmp(res, "u\xC3\xA9" "01") == 0);
+    ice_str_free(res);
+
+    res = ice_str_utf8_sub(text, 60, 63);
+    ICE_TEST_ASSERT_TRUE(strcmp(res, "s\xE6\x97\xA5\xF0\x9F\x98\x80" "0") == 0);
+    ice_str_free(res);
+
+    res = ice_str_utf8_sub(text, codepoints - 4, codepoints - 1);
+    ICE_TEST_ASSERT_TRUE(strcmp(res, "\xE6\x9C\xAC" "end") == 0);
+    ice_str_free(res);
+
+    // Reversed codepoints keep their bytes in order
+    for (int i = 7; i >= 0; i--) {
+        if (parts[i][0] & 0x80) {
+            strcat(expected, parts[i]);
+        } else {
+            int len = (int) strlen(parts[i]), at = (int) strlen(expected);
+            for (int j = 0; j < len; j++) expected[at + j] = parts[i][len - 1 - j];
+            expected[at + len] = '\0';
+        }
+    }
+
+    res = ice_str_utf8_rev(text);
+    ICE_TEST_ASSERT_TRUE(strcmp(res, expected) == 0);
+    ice_str_free(res);
+
+    printf("TEST utf8_across_blocks RAN SUCCESSFULLY!\n");
+}
+
+int main(int argc, char** argv) {
+    arena_keeps_heap_buffers();
+    search_across_blocks();
+    tokenizer_spans();
+    utf8_across_blocks();
+    return 0;
+}